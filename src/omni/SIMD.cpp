@@ -258,6 +258,66 @@ bool Capability::is_3DNow()
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief Is AVX supported?
+bool Capability::is_AVX()
+{
+	__try
+	{
+		{ // check feature
+			int info[4] = {0};
+
+			// TODO: check processor?
+			__cpuid(info, 1);
+			if (~info[2]&(1<<28)) // ECX, bit 28
+				return false;
+			if (~info[2]&(1<<27)) // ECX, bit 27 (OSXSAVE)
+				return false;
+		}
+
+		// check OS support (XMM and YMM state)
+		if (6 != (_xgetbv(0)&6))
+			return false;
+	}
+	__except (1) // EXCEPTION_EXECUTE_HANDLER
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Is AVX2 supported?
+bool Capability::is_AVX2()
+{
+	if (!is_AVX())
+		return false;
+
+	__try
+	{
+		{ // check feature
+			int info[4] = {0};
+
+			__cpuid(info, 0);
+			if (info[0] < 7) // max leaf
+				return false;
+
+			__cpuidex(info, 7, 0);
+			if (~info[1]&(1<<5)) // EBX, bit 5
+				return false;
+		}
+	}
+	__except (1) // EXCEPTION_EXECUTE_HANDLER
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
 //// TODO: manual capability setup (at compile time)?
 const bool Capability::MMX = Capability::is_MMX();
 const bool Capability::SSE = Capability::is_SSE();
@@ -267,6 +327,8 @@ const bool Capability::SSSE3 = Capability::is_SSSE3();
 const bool Capability::SSE4_1 = Capability::is_SSE4_1();
 const bool Capability::SSE4_2 = Capability::is_SSE4_2();
 const bool Capability::_3DNow = Capability::is_3DNow();
+const bool Capability::AVX = Capability::is_AVX();
+const bool Capability::AVX2 = Capability::is_AVX2();
 
 	} // Capability
 
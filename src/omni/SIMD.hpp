@@ -53,6 +53,8 @@ namespace omni
 		static const bool SSE4_1; ///< @brief Is SSE4.1 supported?
 		static const bool SSE4_2; ///< @brief Is SSE4.2 supported?
 		static const bool _3DNow; ///< @brief Is 3DNow! supported?
+		static const bool AVX;  ///< @brief Is AVX supported?
+		static const bool AVX2; ///< @brief Is AVX2 supported?
 
 	private:
 		static bool is_MMX();
@@ -63,6 +65,8 @@ namespace omni
 		static bool is_SSE4_1();
 		static bool is_SSE4_2();
 		static bool is_3DNow();
+		static bool is_AVX();
+		static bool is_AVX2();
 	};
 
 
@@ -178,7 +182,7 @@ T1 dot_T(size_t N, const T1 *X, const T2 *Y)
 template<typename T1, typename T2> inline
 T1 dot(size_t N, const T1 *X, const T2 *Y)
 {
-	return dot_T(N, Z, X, Y);
+	return dot_T(N, X, Y);
 }
 
 // automatic
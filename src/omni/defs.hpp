@@ -240,6 +240,44 @@
 #endif // OMNI_DOXY_MODE
 
 
+///////////////////////////////////////////////////////////////////////////////
+// OMNI_TLS macro
+#if defined(OMNI_DOXY_MODE)
+/** @brief Thread local storage specifier.
+
+		This macro is used to declare the static variable
+	which has separate instance for each thread. In @a MULTI-THREAD mode
+	(i.e. if #OMNI_MT is defined to nonzero value) this macro is expanded
+	to the compiler specific storage specifier. Otherwise this macro
+	is expanded to nothing, so the variable is ordinary static variable.
+
+@code
+	int& counter()
+	{
+		static OMNI_TLS int COUNTER = 0;
+		return COUNTER;
+	}
+@endcode
+
+		Only POD types with constant initializer
+	can be declared as thread local variables.
+
+@see @ref omni_defs_multithread
+*/
+#define OMNI_TLS
+#else
+#if OMNI_MT
+#	if defined(_MSC_VER) || defined(__BORLANDC__)
+#		define OMNI_TLS __declspec(thread)
+#	else
+#		define OMNI_TLS __thread
+#	endif
+#else
+#	define OMNI_TLS
+#endif
+#endif // OMNI_DOXY_MODE
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // OMNI_UNICODE macro
 #if defined(OMNI_DOXY_MODE)
@@ -520,6 +558,10 @@ private: // copying not allowed
 	}
 @endcode
 
+		#OMNI_TLS macro declares per-thread static variables. Such variables
+	can be used without any synchronization. If @a MULTI-THREAD mode
+	disabled, then these variables are ordinary static variables.
+
 
 @section omni_defs_unicode UNICODE mode
 
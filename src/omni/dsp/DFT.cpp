@@ -15,7 +15,13 @@
 	@author Sergey Polichnoy
 */
 #include <omni/dsp/DFT.h>
+#include <omni/dsp/DFT_fixed.h>
 #include <omni/util.hpp>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <immintrin.h>
 
 #include <functional>
 #include <algorithm>
@@ -24,24 +30,283 @@
 #include <mkl_dfti.h>
 #endif
 
-#if OMNI_MT && !defined(OMNI_USE_MKL)
+#if OMNI_MT
 #include <omni/sync.hpp>
+#include <windows.h>
 using namespace omni::sync;
 #endif
 
+#include <omni/conf.hpp>
+
+#include <map>
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if !defined(OMNI_USE_MKL)
+#	if defined(__GNUC__)
+		// AVX code is compiled without global -mavx option
+#		define DFT_AVX_TARGET __attribute__((target("avx")))
+#	else
+#		define DFT_AVX_TARGET
+#	endif
+#endif // !OMNI_USE_MKL
+
+#if defined(__GNUC__)
+	// SSSE3 code is compiled without global -mssse3 option
+#	define DFT_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#	define DFT_SSSE3_TARGET
+#endif
+
 namespace omni
 {
 	namespace dsp
 	{
 
+namespace details
+{
+
+// minimum number of samples per worker thread
+enum { BATCH_GRAIN = 32*1024 };
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief parallel job
+/*
+		The job processes the items [first, last).
+	The run() method can be called from several threads.
+*/
+class DFT_Job {
+public:
+	virtual ~DFT_Job() {}
+	virtual void run(size_t first, size_t last) const = 0;
+};
+
+#if OMNI_MT
+
+// @brief part of the job
+struct DFT_JobPart {
+	const DFT_Job *job;
+	size_t first;
+	size_t last;
+};
+
+
+// @brief persistent worker threads
+/*
+		The workers are started on demand and wait for the job parts
+	until program exit, so the parallel job doesn't pay for the thread
+	creation. Only one job is executed at a time: the nested (from the
+	job itself) or concurrent parallel job is executed by the calling
+	thread.
+*/
+class DFT_Workers: private omni::NonCopyable {
+public:
+	enum { MAX_THREADS = 32 };
+
+	DFT_Workers()
+		: m_busy(0), m_count(0)
+	{}
+
+public:
+	// execute the parts [1, N_parts) by workers and the part 0 by the
+	// calling thread, returns false if the workers are busy
+	bool run(const DFT_JobPart *parts, size_t N_parts)
+	{
+		if (0 != InterlockedCompareExchange(&m_busy, 1, 0))
+			return false;
+
+		DWORD N_started = 0;
+		for (size_t k = 1; k < N_parts; ++k)
+		{
+			if (N_started < m_count || start())
+			{
+				Worker &w = m_workers[N_started++];
+				w.part = parts[k];
+				SetEvent(w.start);
+			}
+			else
+				parts[k].job->run(parts[k].first, parts[k].last);
+		}
+
+		parts[0].job->run(parts[0].first, parts[0].last);
+
+		if (N_started)
+			WaitForMultipleObjects(N_started, m_done, TRUE, INFINITE);
+
+		InterlockedExchange(&m_busy, 0);
+		return true;
+	}
+
+private:
+	struct Worker
+	{
+		HANDLE start; // the part is ready (auto-reset)
+		HANDLE done;  // the part is done (auto-reset)
+		DFT_JobPart part;
+	};
+
+	// worker thread function
+	static DWORD WINAPI thread_proc(void *arg)
+	{
+		Worker *w = static_cast<Worker*>(arg);
+		while (WAIT_OBJECT_0 == WaitForSingleObject(w->start, INFINITE))
+		{
+			w->part.job->run(w->part.first, w->part.last);
+			SetEvent(w->done);
+		}
+
+		return 0;
+	}
+
+	// start one more worker
+	bool start()
+	{
+		if (size_t(MAX_THREADS) <= m_count)
+			return false;
+
+		Worker &w = m_workers[m_count];
+		w.start = CreateEvent(0, FALSE, FALSE, 0);
+		w.done = CreateEvent(0, FALSE, FALSE, 0);
+
+		HANDLE h = (w.start && w.done)
+			? CreateThread(0, 0, thread_proc, &w, 0, 0) : 0;
+		if (!h)
+		{
+			if (w.start) CloseHandle(w.start);
+			if (w.done) CloseHandle(w.done);
+			return false;
+		}
+
+		CloseHandle(h); // the thread is never joined
+		m_done[m_count++] = w.done;
+		return true;
+	}
+
+private:
+	volatile LONG m_busy;
+	size_t m_count; // number of started workers
+	Worker m_workers[MAX_THREADS];
+	HANDLE m_done[MAX_THREADS];
+};
+
+
+// @brief the worker threads (never released)
+DFT_Workers& dft_workers()
+{
+	static void* volatile W = 0;
+	if (!W)
+	{
+		DFT_Workers *w = new DFT_Workers();
+		if (InterlockedCompareExchangePointer(&W, w, 0))
+			delete w; // published by another thread
+	}
+
+	return *static_cast<DFT_Workers*>(W);
+}
+
+
+// @brief number of available processors
+size_t dft_cpus()
+{
+	static size_t N = 0;
+	if (!N)
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		N = info.dwNumberOfProcessors
+			? info.dwNumberOfProcessors : 1;
+	}
+
+	return N;
+}
+
+#endif // OMNI_MT
+
+
+// @brief parallel job execution
+/*
+		The @a count items of @a item_size samples are split into the
+	contiguous parts, one part per thread (at least BATCH_GRAIN samples).
+	The calling thread processes the first part itself, the other parts
+	are processed by the persistent workers. If a worker thread cannot
+	be started, its part is processed by the calling thread.
+*/
+void dft_parallel(const DFT_Job &job, size_t count, size_t item_size)
+{
+#if OMNI_MT
+	size_t N_threads = count*item_size / BATCH_GRAIN;
+	N_threads = std::min(N_threads, dft_cpus());
+	N_threads = std::min(N_threads, size_t(DFT_Workers::MAX_THREADS));
+	N_threads = std::min(N_threads, count);
+
+	if (1 < N_threads)
+	{
+		DFT_JobPart parts[DFT_Workers::MAX_THREADS];
+		for (size_t k = 0, first = 0; k < N_threads; ++k)
+		{
+			const size_t last = count*(k+1) / N_threads;
+			parts[k].job = &job;
+			parts[k].first = first;
+			parts[k].last = last;
+			first = last;
+		}
+
+		if (dft_workers().run(parts, N_threads))
+			return;
+	}
+#else
+	(void)item_size; // unused
+#endif // OMNI_MT
+
+	job.run(0, count);
+}
+
+} // details namespace
+
+
 #if !defined(OMNI_USE_MKL)
 namespace details
 {
 
+// mixed-radix factorization
+bool fft_factorize(size_t N, std::vector<size_t> &factors);
+
+// minimum size for Bluestein's algorithm
+enum { BLUESTEIN_MIN = 32 };
+
+// minimum size for four-step algorithm (exceeds L2 cache)
+enum { FOUR_STEP_MIN = 1<<20 };
+
+// transform algorithms
+enum DFT_Plan
+{
+	PLAN_ESTIMATE,  // selected by size
+	PLAN_RADIX4,    // radix-4 (power of two sizes)
+	PLAN_MIXED,     // mixed-radix (2,3,5,7-smooth sizes)
+	PLAN_BLUESTEIN, // Bluestein's algorithm
+	PLAN_DIRECT,    // direct DFT
+	PLAN_FOUR_STEP  // four-step (large composite sizes)
+};
+
+// the default plan
+DFT_Plan dft_estimate(size_t N);
+
+
 //////////////////////////////////////////////////////////////////////////
 // @brief DFT Table
+/*
+		The table contains the N roots of unity and the transform plan:
+	radix-4 stage twiddles, mixed-radix factors, Bluestein's chirp
+	(and power of two convolution table) or four-step sub-tables
+	(the four-step twiddles are taken from the roots of unity).
+	The direct DFT needs no plan data.
+*/
 template<typename T>
-class DFT_Table {
+class DFT_Table: private omni::NonCopyable {
 public:
 	typedef typename DFT<T>::scalar_type scalar_type;
 	typedef typename DFT<T>::value_type value_type;
@@ -49,12 +314,30 @@ public:
 
 public:
 	// table creation
-	explicit DFT_Table(size_type N)
-		: m_table(N)
+	explicit DFT_Table(size_type N, DFT_Plan plan = PLAN_ESTIMATE)
+		: m_table(N), m_conv(0), m_rows(0), m_sub1(0), m_sub2(0)
 	{
 		for (size_type i = 0; i < N; ++i)
 			m_table[i] = std::polar(scalar_type(1),
 				scalar_type(i*2*omni::util::PI / N));
+
+		if (PLAN_ESTIMATE == plan)
+			plan = dft_estimate(N);
+		m_plan = plan;
+
+		switch (plan)
+		{
+			case PLAN_RADIX4:    init_stages(N); break;
+			case PLAN_MIXED:     fft_factorize(N, m_factors); break;
+			case PLAN_BLUESTEIN: init_bluestein(N); break;
+			case PLAN_FOUR_STEP: init_four_step(N); break;
+			default: break;
+		}
+	}
+
+	~DFT_Table()
+	{
+		delete m_conv;
 	}
 
 public:
@@ -71,158 +354,261 @@ public:
 		return m_table.size();
 	}
 
+	// transform plan (never PLAN_ESTIMATE)
+	DFT_Plan plan() const
+	{
+		return m_plan;
+	}
+
+public:
+	// mixed-radix factors: (radix, remain) pairs
+	const std::vector<size_type>& factors() const
+	{
+		return m_factors;
+	}
+
+	// Bluestein's chirp: exp(i*pi*n*n/N)
+	const std::vector<value_type>& chirp() const
+	{
+		return m_chirp;
+	}
+
+	// forward transform of the convolution chirp
+	const std::vector<value_type>& chirp_fft() const
+	{
+		return m_chirp_fft;
+	}
+
+	// power of two convolution table (0 if not used)
+	const DFT_Table* conv() const
+	{
+		return m_conv;
+	}
+
+	// radix-4 stage twiddles: { w1[NR], w2[NR] } for each stage
+	const value_type* stages() const
+	{
+		return m_stages.empty() ? 0 : &m_stages[0];
+	}
+
+	// scratch size of the in-place transform (see dft_transform())
+	size_type work_size() const
+	{
+		if (m_conv)
+			return m_chirp_fft.size();
+		if (!m_stages.empty())
+			return 0;
+
+		return size();
+	}
+
+	// four-step: number of rows N1 (0 if not used)
+	size_type rows() const
+	{
+		return m_rows;
+	}
+
+	// four-step: N1 and N2 sub-transform tables
+	const DFT_Table* sub1() const { return m_sub1; }
+	const DFT_Table* sub2() const { return m_sub2; }
+
+private:
+	void init_stages(size_type N);
+	void init_bluestein(size_type N);
+	void init_four_step(size_type N);
+
 private:
 	std::vector<value_type> m_table;
+	DFT_Plan m_plan;
+	std::vector<value_type> m_stages;
+	std::vector<size_type> m_factors;
+
+	std::vector<value_type> m_chirp;
+	std::vector<value_type> m_chirp_fft;
+	DFT_Table *m_conv;
+
+	size_type m_rows;
+	const DFT_Table *m_sub1; // owned by registry
+	const DFT_Table *m_sub2; // owned by registry
 };
 
 
+// the transform plan (estimated or measured)
+template<typename T>
+	DFT_Plan dft_plan(const T*, size_t N);
+
+// planner epoch (changed with wisdom or mode)
+volatile long& dft_plan_epoch();
+
+
 //////////////////////////////////////////////////////////////////////////
-// @brief DFT Table manager
+// @brief DFT Table registry
+/*
+		The registry is a lock-free list of immutable tables.
+	The table is created without any lock and is published by
+	atomic compare-and-swap of the list head. If another thread
+	has published the table of the same size first, the new table
+	is destroyed and the published one is used.
+
+		The tables are never released until program exit, so the
+	table pointer can be used without reference counting.
+	The table is found by size and plan, so the table of the old
+	plan is not used after the wisdom is changed.
+
+		The small per-thread cache is used to skip the list lookup.
+	The cache is cleared when the planner epoch is changed.
+*/
 template<typename T>
-class DFT_Manager: private omni::NonCopyable {
+class DFT_Registry: private omni::NonCopyable {
 public:
 	typedef DFT_Table<T> table_type;
 	typedef typename table_type::size_type size_type;
 
 public:
-	~DFT_Manager()
+	DFT_Registry()
+		: m_head(0)
+	{}
+
+	~DFT_Registry()
 	{
 		// release all tables
-		for (size_type i = 0; i < m_tables.size(); ++i)
+		Node *node = static_cast<Node*>(m_head);
+		while (node)
 		{
-			assert(0==m_tables[i].N_refs && "table not used");
-			delete m_tables[i].table;
+			Node *next = node->next;
+			delete node->table;
+			delete node;
+			node = next;
 		}
 	}
 
-	// release unused tables
-	void clear()
+public:
+	// get table (create if not exists)
+	const table_type* get(size_type N)
 	{
-		for (size_type i = 0; i < m_tables.size(); ++i)
-			if (0 == m_tables[i].N_refs)
+		enum { CACHE_SIZE = 8 };
+		static OMNI_TLS const table_type *CACHE[CACHE_SIZE] = {0};
+		static OMNI_TLS long CACHE_EPOCH = 0;
+
+		const long epoch = dft_plan_epoch();
+		if (CACHE_EPOCH != epoch)
 		{
-			delete m_tables[i].table;
-			m_tables.erase(m_tables.begin()+i);
-			--i; // (!)
+			for (size_t i = 0; i < CACHE_SIZE; ++i)
+				CACHE[i] = 0;
+			CACHE_EPOCH = epoch;
 		}
-	}
 
-	// get table
-	table_type* get(size_type N)
-	{
-		Item &item = find(N);
-		item.N_refs += 1;
+		const table_type* &cached = CACHE[N%CACHE_SIZE];
+		if (!cached || cached->size() != N)
+			cached = find_or_create(N);
 
-		return item.table;
+		return cached;
 	}
 
-	// release table
-	void put(table_type *t)
+private:
+	struct Node
 	{
-		Item &item = find(t->size());
-		assert(0<item.N_refs && "table is used");
-		item.N_refs -= 1;
-	}
+		const table_type *table;
+		Node *next;
+	};
 
 private:
-	struct Item
+	// find table in the list [node, last)
+	static const table_type* find(const Node *node, const Node *last, size_type N, DFT_Plan plan)
 	{
-		table_type *table;
-		size_type N_refs; // number of references
+		for (; node != last; node = node->next)
+			if (node->table->size() == N && node->table->plan() == plan)
+				return node->table;
 
-		explicit Item(table_type *t = 0)
-			: table(t), N_refs(0) {}
-	};
+		return 0;
+	}
 
-	struct FindCmp: public std::binary_function<Item, size_type, bool>
+	// find table or create and publish the new one
+	const table_type* find_or_create(size_type N)
 	{
-		bool operator()(const Item &t, size_type N) const
-		{
-			return t.table->size() < N;
-		}
+		DFT_Plan plan = dft_plan((T*)0, N);
+		if (PLAN_ESTIMATE == plan)
+			plan = dft_estimate(N);
 
-		// VC8 "debug" check
-		bool operator()(const Item &t1, const Item &t2) const
-			{ return t1.table->size() < t2.table->size(); }
-		bool operator()(size_type N, const Item &t) const
-			{ return !(*this)(t, N); }
-	};
+		Node *head = static_cast<Node*>(m_head);
+		if (const table_type *found = find(head, 0, N, plan))
+			return found;
 
-private:
-	// find table (create if not exists)
-	Item& find(size_type N)
-	{
-		typename std::vector<Item>::iterator found = std::lower_bound(
-			m_tables.begin(), m_tables.end(), N, FindCmp());
+		Node *node = new Node();
+		node->table = new table_type(N, plan);
+
+		for (;;)
+		{
+			node->next = head;
+
+#if OMNI_MT
+			void *prev = InterlockedCompareExchangePointer(&m_head, node, head);
+#else
+			void *prev = m_head;
+			if (prev == head)
+				m_head = node;
+#endif
+			if (prev == head)
+				return node->table;
 
-		if (found == m_tables.end() || (*found).table->size() != N)
-			found = m_tables.insert(found, Item(new table_type(N)));
+			// the list is changed, check new items only
+			Node *new_head = static_cast<Node*>(prev);
+			if (const table_type *found = find(new_head, head, N, plan))
+			{
+				delete node->table;
+				delete node;
+				return found;
+			}
 
-		return *found;
+			head = new_head;
+		}
 	}
 
 private:
-	std::vector<Item> m_tables;
+	void* volatile m_head; // list of Node
 };
 
 
 //////////////////////////////////////////////////////////////////////////
-// global synchronization
-#if OMNI_MT
-	CriticalSection& dft_lock()
-	{
-		static CriticalSection LOCK;
-		return LOCK;
-	}
-#endif
-
-//////////////////////////////////////////////////////////////////////////
-// global table manager
+// global table registry
 template<typename T>
-	DFT_Manager<T>& dft_tables(const T* = 0) // avoid VC6 bug
+	DFT_Registry<T>& dft_tables(const T* = 0) // avoid VC6 bug
 {
-	static DFT_Manager<T> MANAGER;
-	return MANAGER;
+	static DFT_Registry<T> REGISTRY;
+	return REGISTRY;
 }
 
 
-// @brief Danielson-Lanczos algorithm
-template<bool is_fwd, typename T>
-void fft_algorithm(std::complex<T> *data, size_t N_log2, const DFT_Table<T> &phase)
+// @brief bit-reversal reordering
+template<typename T>
+void fft_reordering(std::complex<T> *data, size_t N)
 {
-	const size_t MOD = (1<<N_log2) - 1;
-	size_t NL = (1<<N_log2) / 2;
-	size_t NR = 1;
-
-	for (size_t i = 0; i < N_log2; ++i)
+	for (size_t i = 0, L = 0; i < N-1; ++i)
 	{
-		for (size_t L = 0; L < NL; ++L)
-			for (size_t R = 0; R < NR; ++R)
-			{
-				size_t p = R + 2*L*NR;
-				size_t q = p + NR;
-
-				std::complex<T> tmp = is_fwd
-					? std::conj(phase[(R*NL) & MOD])
-					: phase[(R*NL) & MOD];
-
-				tmp *= data[q];
-				data[q] = data[p] - tmp;
-				data[p] += tmp;
-			}
+		if (i < L) std::swap(data[L], data[i]);
 
-		NL /= 2;
-		NR *= 2;
+		size_t R = N/2;
+		while (R <= L)
+		{
+			L -= R;
+			R /= 2;
+		}
+		L += R;
 	}
 }
 
-// @brief bit-reversal reordering
+
+// @brief bit-reversal reordering (out of place)
+/*
+		The strided input x[i*stride] is copied to out[bitrev(i)].
+*/
 template<typename T>
-void fft_reordering(std::complex<T> *data, size_t N)
+void fft_reordering(std::complex<T> *out, const std::complex<T> *x,
+	ptrdiff_t stride, size_t N)
 {
 	for (size_t i = 0, L = 0; i < N-1; ++i)
 	{
-		if (i < L) std::swap(data[L], data[i]);
+		out[L] = x[ptrdiff_t(i)*stride];
 
 		size_t R = N/2;
 		while (R <= L)
@@ -232,72 +618,1365 @@ void fft_reordering(std::complex<T> *data, size_t N)
 		}
 		L += R;
 	}
+
+	out[N-1] = x[ptrdiff_t(N-1)*stride];
 }
 
-// @brief DFT transformation
-template<bool is_fwd, typename T>
-void dft_algorithm(std::complex<T> *data, size_t N, const DFT_Table<T> &phase)
+//////////////////////////////////////////////////////////////////////////
+// radix-4 stage twiddles initialization
+/*
+		Each radix-4 stage merges two radix-2 stages of span NR and 2*NR.
+	The stage twiddles are stored contiguously: w1[R] = W(2*NR)^R
+	and w2[R] = W(4*NR)^R, where W(M) = exp(2*pi*i/M) and R < NR.
+	The first stage is radix-2 if log2(N) is odd.
+*/
+template<typename T>
+void DFT_Table<T>::init_stages(size_type N)
 {
-	std::vector< std::complex<T> > tmp(data, data+N);
+	const size_type N_log2 = omni::util::log2(N);
 
-	for (size_t i = 0; i < N; ++i)
+	for (size_type NR = (N_log2%2) ? 2 : 1; 4*NR <= N; NR *= 4)
 	{
-		std::complex<T> sum = T();
-		for (size_t k = 0; k < N; ++k)
-			sum += tmp[k] * (is_fwd
-				? std::conj(phase[(i*k) % N])
-				: phase[(i*k) % N]);
-
-		data[i] = sum;
+		for (size_type R = 0; R < NR; ++R)
+			m_stages.push_back(value_type(std::polar(1.0,
+				2*omni::util::PI * double(R) / double(2*NR))));
+		for (size_type R = 0; R < NR; ++R)
+			m_stages.push_back(value_type(std::polar(1.0,
+				2*omni::util::PI * double(R) / double(4*NR))));
 	}
 }
 
-} // details namespace
-#endif // !OMNI_USE_MKL
-
 
-#if defined(OMNI_USE_MKL)
-
-//////////////////////////////////////////////////////////////////////////
-// DFT initialization
-template<typename T>
-void DFT<T>::init()
+// @brief radix-4 stage (general version)
+/*
+		Two radix-2 stages of span NR and 2*NR at one pass.
+	The input is in bit-reversed order.
+*/
+template<bool is_fwd, typename T>
+void fft_stage4_T(std::complex<T> *data, size_t N, size_t NR,
+	const std::complex<T> *W1, const std::complex<T> *W2)
 {
-	// create descriptor
-	long ret = DftiCreateDescriptor((DFTI_DESCRIPTOR_HANDLE*)&m_impl,
-		sizeof(T) < sizeof(double) ? DFTI_SINGLE:DFTI_DOUBLE,
-			DFTI_COMPLEX, 1, m_size);
-	assert(DFTI_NO_ERROR==ret && "DFTI descriptor creation");
+	for (size_t base = 0; base < N; base += 4*NR)
+	{
+		std::complex<T> *x = data + base;
+		for (size_t R = 0; R < NR; ++R, ++x)
+		{
+			const std::complex<T> w1 = is_fwd ? std::conj(W1[R]) : W1[R];
+			const std::complex<T> w2 = is_fwd ? std::conj(W2[R]) : W2[R];
 
-	// set forward scale
-	ret = DftiSetValue((DFTI_DESCRIPTOR_HANDLE)m_impl, DFTI_FORWARD_SCALE, m_fwd_scale);
-	assert(DFTI_NO_ERROR==ret && "set DFTI forward scale");
+			const std::complex<T> t1 = x[NR] * w1;
+			const std::complex<T> t3 = x[3*NR] * w1;
 
-	// set inverse scale
-	ret = DftiSetValue((DFTI_DESCRIPTOR_HANDLE)m_impl, DFTI_BACKWARD_SCALE, m_inv_scale);
-	assert(DFTI_NO_ERROR==ret && "set DFTI backward scale");
+			const std::complex<T> a = x[0] + t1;
+			const std::complex<T> b = x[0] - t1;
+			const std::complex<T> c = (x[2*NR] + t3) * w2;
+			std::complex<T> d = (x[2*NR] - t3) * w2;
 
-	// commit descriptor
-	ret = DftiCommitDescriptor((DFTI_DESCRIPTOR_HANDLE)m_impl);
-	assert(DFTI_NO_ERROR==ret && "DFTI descriptor commit");
+			// W(4*NR)^NR = -i (forward) or +i (inverse)
+			d = is_fwd ? std::complex<T>(d.imag(), -d.real())
+				: std::complex<T>(-d.imag(), d.real());
+
+			x[0] = a + c;
+			x[2*NR] = a - c;
+			x[NR] = b + d;
+			x[3*NR] = b - d;
+		}
+	}
 }
 
 
-//////////////////////////////////////////////////////////////////////////
-// DFT destruction
-template<typename T>
-DFT<T>::~DFT()
+// complex multiplication (SSE2, one double complex)
+inline __m128d cmul_SSE2(__m128d a, __m128d b)
 {
-	// release descriptor
-	long ret = DftiFreeDescriptor((DFTI_DESCRIPTOR_HANDLE*)&m_impl);
-	ret; assert(DFTI_NO_ERROR==ret && "DFTI descriptor destruction");
-}
+	const __m128d br = _mm_unpacklo_pd(b, b);
+	const __m128d bi = _mm_unpackhi_pd(b, b);
+	const __m128d as = _mm_shuffle_pd(a, a, 1);
+	const __m128d sign = _mm_set_pd(0.0, -0.0);
 
+	return _mm_add_pd(_mm_mul_pd(a, br),
+		_mm_xor_pd(_mm_mul_pd(as, bi), sign));
+}
 
-//////////////////////////////////////////////////////////////////////////
-// forward transform
-template<typename T>
-void DFT<T>::forward(value_type *data)
+// complex multiplication (SSE2, two float complex)
+inline __m128 cmul_SSE2(__m128 a, __m128 b)
+{
+	const __m128 br = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2,2,0,0));
+	const __m128 bi = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,3,1,1));
+	const __m128 as = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2,3,0,1));
+	const __m128 sign = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+
+	return _mm_add_ps(_mm_mul_ps(a, br),
+		_mm_xor_ps(_mm_mul_ps(as, bi), sign));
+}
+
+
+// @brief radix-4 stage (SSE2 version, double)
+template<bool is_fwd>
+void fft_stage4_SSE2(std::complex<double> *data, size_t N, size_t NR,
+	const std::complex<double> *W1, const std::complex<double> *W2)
+{
+	// conjugate twiddles for forward transform
+	const __m128d wsign = is_fwd ? _mm_set_pd(-0.0, 0.0) : _mm_setzero_pd();
+	// multiplication by -i (forward) or +i (inverse) after swap
+	const __m128d dsign = is_fwd ? _mm_set_pd(-0.0, 0.0) : _mm_set_pd(0.0, -0.0);
+
+	for (size_t base = 0; base < N; base += 4*NR)
+	{
+		double *x = (double*)(data + base);
+		for (size_t R = 0; R < NR; ++R, x += 2)
+		{
+			const __m128d w1 = _mm_xor_pd(_mm_loadu_pd((const double*)(W1+R)), wsign);
+			const __m128d w2 = _mm_xor_pd(_mm_loadu_pd((const double*)(W2+R)), wsign);
+
+			const __m128d x0 = _mm_loadu_pd(x);
+			const __m128d t1 = cmul_SSE2(_mm_loadu_pd(x + 2*NR), w1);
+			const __m128d x2 = _mm_loadu_pd(x + 4*NR);
+			const __m128d t3 = cmul_SSE2(_mm_loadu_pd(x + 6*NR), w1);
+
+			const __m128d a = _mm_add_pd(x0, t1);
+			const __m128d b = _mm_sub_pd(x0, t1);
+			const __m128d c = cmul_SSE2(_mm_add_pd(x2, t3), w2);
+			__m128d d = cmul_SSE2(_mm_sub_pd(x2, t3), w2);
+			d = _mm_xor_pd(_mm_shuffle_pd(d, d, 1), dsign);
+
+			_mm_storeu_pd(x, _mm_add_pd(a, c));
+			_mm_storeu_pd(x + 4*NR, _mm_sub_pd(a, c));
+			_mm_storeu_pd(x + 2*NR, _mm_add_pd(b, d));
+			_mm_storeu_pd(x + 6*NR, _mm_sub_pd(b, d));
+		}
+	}
+}
+
+
+// @brief radix-4 stage (SSE2 version, float)
+template<bool is_fwd>
+void fft_stage4_SSE2(std::complex<float> *data, size_t N, size_t NR,
+	const std::complex<float> *W1, const std::complex<float> *W2)
+{
+	if (NR < 2) // two complex per register
+	{
+		fft_stage4_T<is_fwd>(data, N, NR, W1, W2);
+		return;
+	}
+
+	const __m128 wsign = is_fwd ? _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f) : _mm_setzero_ps();
+	const __m128 dsign = is_fwd ? _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f) : _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+
+	for (size_t base = 0; base < N; base += 4*NR)
+	{
+		float *x = (float*)(data + base);
+		for (size_t R = 0; R < NR; R += 2, x += 4)
+		{
+			const __m128 w1 = _mm_xor_ps(_mm_loadu_ps((const float*)(W1+R)), wsign);
+			const __m128 w2 = _mm_xor_ps(_mm_loadu_ps((const float*)(W2+R)), wsign);
+
+			const __m128 x0 = _mm_loadu_ps(x);
+			const __m128 t1 = cmul_SSE2(_mm_loadu_ps(x + 2*NR), w1);
+			const __m128 x2 = _mm_loadu_ps(x + 4*NR);
+			const __m128 t3 = cmul_SSE2(_mm_loadu_ps(x + 6*NR), w1);
+
+			const __m128 a = _mm_add_ps(x0, t1);
+			const __m128 b = _mm_sub_ps(x0, t1);
+			const __m128 c = cmul_SSE2(_mm_add_ps(x2, t3), w2);
+			__m128 d = cmul_SSE2(_mm_sub_ps(x2, t3), w2);
+			d = _mm_xor_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2,3,0,1)), dsign);
+
+			_mm_storeu_ps(x, _mm_add_ps(a, c));
+			_mm_storeu_ps(x + 4*NR, _mm_sub_ps(a, c));
+			_mm_storeu_ps(x + 2*NR, _mm_add_ps(b, d));
+			_mm_storeu_ps(x + 6*NR, _mm_sub_ps(b, d));
+		}
+	}
+}
+
+
+// complex multiplication (AVX, two double complex)
+DFT_AVX_TARGET inline __m256d cmul_AVX(__m256d a, __m256d b)
+{
+	const __m256d br = _mm256_movedup_pd(b);
+	const __m256d bi = _mm256_permute_pd(b, 0xF);
+	const __m256d as = _mm256_permute_pd(a, 0x5);
+
+	return _mm256_addsub_pd(_mm256_mul_pd(a, br), _mm256_mul_pd(as, bi));
+}
+
+// complex multiplication (AVX, four float complex)
+DFT_AVX_TARGET inline __m256 cmul_AVX(__m256 a, __m256 b)
+{
+	const __m256 br = _mm256_moveldup_ps(b);
+	const __m256 bi = _mm256_movehdup_ps(b);
+	const __m256 as = _mm256_permute_ps(a, _MM_SHUFFLE(2,3,0,1));
+
+	return _mm256_addsub_ps(_mm256_mul_ps(a, br), _mm256_mul_ps(as, bi));
+}
+
+
+// @brief radix-4 stage (AVX version, double)
+template<bool is_fwd> DFT_AVX_TARGET
+void fft_stage4_AVX(std::complex<double> *data, size_t N, size_t NR,
+	const std::complex<double> *W1, const std::complex<double> *W2)
+{
+	if (NR < 2) // two complex per register
+	{
+		fft_stage4_SSE2<is_fwd>(data, N, NR, W1, W2);
+		return;
+	}
+
+	const __m256d wsign = is_fwd ? _mm256_set_pd(-0.0, 0.0, -0.0, 0.0) : _mm256_setzero_pd();
+	const __m256d dsign = is_fwd ? _mm256_set_pd(-0.0, 0.0, -0.0, 0.0) : _mm256_set_pd(0.0, -0.0, 0.0, -0.0);
+
+	for (size_t base = 0; base < N; base += 4*NR)
+	{
+		double *x = (double*)(data + base);
+		for (size_t R = 0; R < NR; R += 2, x += 4)
+		{
+			const __m256d w1 = _mm256_xor_pd(_mm256_loadu_pd((const double*)(W1+R)), wsign);
+			const __m256d w2 = _mm256_xor_pd(_mm256_loadu_pd((const double*)(W2+R)), wsign);
+
+			const __m256d x0 = _mm256_loadu_pd(x);
+			const __m256d t1 = cmul_AVX(_mm256_loadu_pd(x + 2*NR), w1);
+			const __m256d x2 = _mm256_loadu_pd(x + 4*NR);
+			const __m256d t3 = cmul_AVX(_mm256_loadu_pd(x + 6*NR), w1);
+
+			const __m256d a = _mm256_add_pd(x0, t1);
+			const __m256d b = _mm256_sub_pd(x0, t1);
+			const __m256d c = cmul_AVX(_mm256_add_pd(x2, t3), w2);
+			__m256d d = cmul_AVX(_mm256_sub_pd(x2, t3), w2);
+			d = _mm256_xor_pd(_mm256_permute_pd(d, 0x5), dsign);
+
+			_mm256_storeu_pd(x, _mm256_add_pd(a, c));
+			_mm256_storeu_pd(x + 4*NR, _mm256_sub_pd(a, c));
+			_mm256_storeu_pd(x + 2*NR, _mm256_add_pd(b, d));
+			_mm256_storeu_pd(x + 6*NR, _mm256_sub_pd(b, d));
+		}
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-4 stage (AVX version, float)
+template<bool is_fwd> DFT_AVX_TARGET
+void fft_stage4_AVX(std::complex<float> *data, size_t N, size_t NR,
+	const std::complex<float> *W1, const std::complex<float> *W2)
+{
+	if (NR < 4) // four complex per register
+	{
+		fft_stage4_SSE2<is_fwd>(data, N, NR, W1, W2);
+		return;
+	}
+
+	const __m256 wsign = is_fwd ? _mm256_set_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f) : _mm256_setzero_ps();
+	const __m256 dsign = is_fwd ? _mm256_set_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f)
+		: _mm256_set_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+
+	for (size_t base = 0; base < N; base += 4*NR)
+	{
+		float *x = (float*)(data + base);
+		for (size_t R = 0; R < NR; R += 4, x += 8)
+		{
+			const __m256 w1 = _mm256_xor_ps(_mm256_loadu_ps((const float*)(W1+R)), wsign);
+			const __m256 w2 = _mm256_xor_ps(_mm256_loadu_ps((const float*)(W2+R)), wsign);
+
+			const __m256 x0 = _mm256_loadu_ps(x);
+			const __m256 t1 = cmul_AVX(_mm256_loadu_ps(x + 2*NR), w1);
+			const __m256 x2 = _mm256_loadu_ps(x + 4*NR);
+			const __m256 t3 = cmul_AVX(_mm256_loadu_ps(x + 6*NR), w1);
+
+			const __m256 a = _mm256_add_ps(x0, t1);
+			const __m256 b = _mm256_sub_ps(x0, t1);
+			const __m256 c = cmul_AVX(_mm256_add_ps(x2, t3), w2);
+			__m256 d = cmul_AVX(_mm256_sub_ps(x2, t3), w2);
+			d = _mm256_xor_ps(_mm256_permute_ps(d, _MM_SHUFFLE(2,3,0,1)), dsign);
+
+			_mm256_storeu_ps(x, _mm256_add_ps(a, c));
+			_mm256_storeu_ps(x + 4*NR, _mm256_sub_ps(a, c));
+			_mm256_storeu_ps(x + 2*NR, _mm256_add_ps(b, d));
+			_mm256_storeu_ps(x + 6*NR, _mm256_sub_ps(b, d));
+		}
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-4 algorithm (power of two sizes)
+/*
+		The input should be in bit-reversed order.
+	The stage kernel is selected once by the SIMD capability.
+*/
+template<bool is_fwd, typename T>
+void fft_radix4(std::complex<T> *data, size_t N_log2, const DFT_Table<T> &phase)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(std::complex<T>*, size_t, size_t,
+			const std::complex<T>*, const std::complex<T>*);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::AVX)
+				return &fft_stage4_AVX<is_fwd>;
+			if (SIMD::Capability::SSE2)
+				return &fft_stage4_SSE2<is_fwd>;
+
+			return &fft_stage4_T<is_fwd, T>;
+		}
+	};
+
+	static typename Aux::FuncPtr run = Aux::select();
+
+	const size_t N = size_t(1) << N_log2;
+	size_t NR = 1;
+
+	// radix-2 first stage
+	if (N_log2%2)
+	{
+		for (size_t i = 0; i < N; i += 2)
+		{
+			const std::complex<T> t = data[i+1];
+			data[i+1] = data[i] - t;
+			data[i] += t;
+		}
+
+		NR = 2;
+	}
+
+	// radix-4 stages
+	const std::complex<T> *tw = phase.stages();
+	for (; 4*NR <= N; NR *= 4)
+	{
+		run(data, N, NR, tw, tw + NR);
+		tw += 2*NR;
+	}
+}
+
+
+// @brief DFT transformation
+/*
+		The @a tmp is the scratch buffer of N items.
+*/
+template<bool is_fwd, typename T>
+void dft_algorithm(std::complex<T> *data, size_t N,
+	const DFT_Table<T> &phase, std::complex<T> *tmp)
+{
+	std::copy(data, data+N, tmp);
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		std::complex<T> sum = T();
+		for (size_t k = 0; k < N; ++k)
+			sum += tmp[k] * (is_fwd
+				? std::conj(phase[(i*k) % N])
+				: phase[(i*k) % N]);
+
+		data[i] = sum;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief mixed-radix factorization
+/*
+		The size N is factorized by radix 4, 2, 3, 5 and 7.
+	The result is (radix, remain) pairs, where remain is
+	the size of sub-transforms of the next stages.
+
+	Returns false if N has any other prime factors.
+*/
+bool fft_factorize(size_t N, std::vector<size_t> &factors)
+{
+	const size_t RADIX[] = { 4, 2, 3, 5, 7 };
+	const size_t N_RADIX = sizeof(RADIX)/sizeof(RADIX[0]);
+
+	factors.clear();
+	for (size_t i = 0; i < N_RADIX && 1 < N; )
+	{
+		if (0 == N%RADIX[i])
+		{
+			N /= RADIX[i];
+			factors.push_back(RADIX[i]);
+			factors.push_back(N);
+		}
+		else
+			++i;
+	}
+
+	if (1 != N)
+		factors.clear();
+
+	return !factors.empty();
+}
+
+
+// @brief the twiddle factor
+template<bool is_fwd, typename T> inline
+std::complex<T> twiddle(const DFT_Table<T> &phase, size_t i)
+{
+	return is_fwd ? std::conj(phase[i]) : phase[i];
+}
+
+
+// @brief radix-2 butterfly
+template<bool is_fwd, typename T>
+void fft_butterfly2(std::complex<T> *F, size_t fstride, size_t m, const DFT_Table<T> &phase)
+{
+	for (size_t k = 0; k < m; ++k)
+	{
+		const std::complex<T> t = F[m+k] * twiddle<is_fwd>(phase, k*fstride);
+		F[m+k] = F[k] - t;
+		F[k] += t;
+	}
+}
+
+
+// @brief radix-3 butterfly
+template<bool is_fwd, typename T>
+void fft_butterfly3(std::complex<T> *F, size_t fstride, size_t m, const DFT_Table<T> &phase)
+{
+	const T epi3 = twiddle<is_fwd>(phase, fstride*m).imag();
+
+	for (size_t k = 0; k < m; ++k)
+	{
+		const std::complex<T> s1 = F[k+m] * twiddle<is_fwd>(phase, k*fstride);
+		const std::complex<T> s2 = F[k+2*m] * twiddle<is_fwd>(phase, 2*k*fstride);
+		const std::complex<T> s3 = s1 + s2;
+		const std::complex<T> s0 = (s1 - s2) * epi3;
+
+		const std::complex<T> t = F[k] - s3*T(0.5);
+		F[k] += s3;
+
+		F[k+m] = std::complex<T>(t.real() - s0.imag(), t.imag() + s0.real());
+		F[k+2*m] = std::complex<T>(t.real() + s0.imag(), t.imag() - s0.real());
+	}
+}
+
+
+// @brief radix-4 butterfly
+template<bool is_fwd, typename T>
+void fft_butterfly4(std::complex<T> *F, size_t fstride, size_t m, const DFT_Table<T> &phase)
+{
+	for (size_t k = 0; k < m; ++k)
+	{
+		const std::complex<T> s0 = F[k+m] * twiddle<is_fwd>(phase, k*fstride);
+		const std::complex<T> s1 = F[k+2*m] * twiddle<is_fwd>(phase, 2*k*fstride);
+		const std::complex<T> s2 = F[k+3*m] * twiddle<is_fwd>(phase, 3*k*fstride);
+
+		const std::complex<T> s5 = F[k] - s1;
+		const std::complex<T> s6 = F[k] + s1;
+		const std::complex<T> s3 = s0 + s2;
+		const std::complex<T> s4 = s0 - s2;
+
+		F[k] = s6 + s3;
+		F[k+2*m] = s6 - s3;
+
+		if (is_fwd)
+		{
+			F[k+m] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+			F[k+3*m] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+		}
+		else
+		{
+			F[k+m] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+			F[k+3*m] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+		}
+	}
+}
+
+
+// @brief radix-5 butterfly
+template<bool is_fwd, typename T>
+void fft_butterfly5(std::complex<T> *F, size_t fstride, size_t m, const DFT_Table<T> &phase)
+{
+	const std::complex<T> ya = twiddle<is_fwd>(phase, fstride*m);
+	const std::complex<T> yb = twiddle<is_fwd>(phase, fstride*2*m);
+
+	for (size_t k = 0; k < m; ++k)
+	{
+		const std::complex<T> s0 = F[k];
+		const std::complex<T> s1 = F[k+m] * twiddle<is_fwd>(phase, k*fstride);
+		const std::complex<T> s2 = F[k+2*m] * twiddle<is_fwd>(phase, 2*k*fstride);
+		const std::complex<T> s3 = F[k+3*m] * twiddle<is_fwd>(phase, 3*k*fstride);
+		const std::complex<T> s4 = F[k+4*m] * twiddle<is_fwd>(phase, 4*k*fstride);
+
+		const std::complex<T> s7 = s1 + s4;
+		const std::complex<T> s10 = s1 - s4;
+		const std::complex<T> s8 = s2 + s3;
+		const std::complex<T> s9 = s2 - s3;
+
+		F[k] = s0 + s7 + s8;
+
+		const std::complex<T> s5 = s0 + s7*ya.real() + s8*yb.real();
+		const std::complex<T> s6(s10.imag()*ya.imag() + s9.imag()*yb.imag(),
+			-s10.real()*ya.imag() - s9.real()*yb.imag());
+		F[k+m] = s5 - s6;
+		F[k+4*m] = s5 + s6;
+
+		const std::complex<T> s11 = s0 + s7*yb.real() + s8*ya.real();
+		const std::complex<T> s12(-s10.imag()*yb.imag() + s9.imag()*ya.imag(),
+			s10.real()*yb.imag() - s9.real()*ya.imag());
+		F[k+2*m] = s11 + s12;
+		F[k+3*m] = s11 - s12;
+	}
+}
+
+
+// @brief generic butterfly (used for radix-7)
+template<bool is_fwd, typename T>
+void fft_butterfly(std::complex<T> *F, size_t fstride, size_t m, size_t p, const DFT_Table<T> &phase)
+{
+	const size_t N = phase.size();
+	std::complex<T> tmp[8];
+	assert(p <= 8 && "radix too big");
+
+	for (size_t u = 0; u < m; ++u)
+	{
+		for (size_t q = 0; q < p; ++q)
+			tmp[q] = F[u + q*m];
+
+		for (size_t q = 0; q < p; ++q)
+		{
+			const size_t k = u + q*m;
+			const size_t step = (fstride*k) % N;
+
+			std::complex<T> sum = tmp[0];
+			for (size_t j = 1, t = step; j < p; ++j)
+			{
+				sum += tmp[j] * twiddle<is_fwd>(phase, t);
+				t += step;
+				if (N <= t)
+					t -= N;
+			}
+
+			F[k] = sum;
+		}
+	}
+}
+
+
+// @brief mixed-radix Cooley-Tukey algorithm (out of place)
+/*
+		The output [out, out+N) is the transform of the input
+	sequence x[0], x[fstride*istride], ..., x[(N-1)*fstride*istride].
+	The N is the product of all radices of the factors.
+*/
+template<bool is_fwd, typename T>
+void fft_mixed(std::complex<T> *out, const std::complex<T> *x, size_t fstride,
+	ptrdiff_t istride, const size_t *factors, const DFT_Table<T> &phase)
+{
+	const size_t p = factors[0]; // radix
+	const size_t m = factors[1]; // sub-transform size
+	const ptrdiff_t step = ptrdiff_t(fstride)*istride;
+
+	if (1 == m)
+	{
+		for (size_t i = 0; i < p; ++i)
+			out[i] = x[ptrdiff_t(i)*step];
+	}
+	else
+	{
+		for (size_t i = 0; i < p; ++i)
+			fft_mixed<is_fwd>(out + i*m, x + ptrdiff_t(i)*step,
+				fstride*p, istride, factors+2, phase);
+	}
+
+	switch (p)
+	{
+		case 2: fft_butterfly2<is_fwd>(out, fstride, m, phase); break;
+		case 3: fft_butterfly3<is_fwd>(out, fstride, m, phase); break;
+		case 4: fft_butterfly4<is_fwd>(out, fstride, m, phase); break;
+		case 5: fft_butterfly5<is_fwd>(out, fstride, m, phase); break;
+		default: fft_butterfly<is_fwd>(out, fstride, m, p, phase); break;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Bluestein's chirp initialization
+template<typename T>
+void DFT_Table<T>::init_bluestein(size_type N)
+{
+	size_type M = 1; // convolution size
+	while (M < 2*N-1)
+		M *= 2;
+
+	// chirp: exp(i*pi*n*n/N), n*n is calculated modulo 2N
+	m_chirp.resize(N);
+	for (size_type n = 0; n < N; ++n)
+	{
+		const size_type k = (n*n) % (2*N);
+		m_chirp[n] = std::polar(scalar_type(1),
+			scalar_type(omni::util::PI * double(k) / double(N)));
+	}
+
+	// symmetric convolution kernel
+	m_chirp_fft.assign(M, value_type());
+	m_chirp_fft[0] = m_chirp[0];
+	for (size_type n = 1; n < N; ++n)
+		m_chirp_fft[n] = m_chirp_fft[M-n] = m_chirp[n];
+
+	m_conv = new DFT_Table(M, PLAN_RADIX4); // fft_radix4() needs the stages
+	fft_reordering(&m_chirp_fft[0], M);
+	fft_radix4<true>(&m_chirp_fft[0],
+		omni::util::log2(M), *m_conv);
+}
+
+
+// @brief Bluestein's algorithm
+/*
+		The DFT of any size N is calculated as the power of two
+	convolution with the chirp sequence. The @a a is the scratch
+	buffer of M items (the convolution size).
+*/
+template<bool is_fwd, typename T>
+void bluestein_algorithm(std::complex<T> *data, size_t N,
+	const DFT_Table<T> &phase, std::complex<T> *a)
+{
+	const std::vector< std::complex<T> > &chirp = phase.chirp();
+	const std::vector< std::complex<T> > &B = phase.chirp_fft();
+	const DFT_Table<T> &conv = *phase.conv();
+	const size_t M = B.size();
+	const size_t M_log2 = omni::util::log2(M);
+
+	for (size_t n = 0; n < N; ++n)
+		a[n] = data[n] * (is_fwd ? std::conj(chirp[n]) : chirp[n]);
+	std::fill(a+N, a+M, std::complex<T>());
+
+	// convolution: ifft(fft(a) * B)
+	fft_reordering(a, M);
+	fft_radix4<true>(a, M_log2, conv);
+	for (size_t k = 0; k < M; ++k)
+		a[k] *= (is_fwd ? B[k] : std::conj(B[k]));
+	fft_reordering(a, M);
+	fft_radix4<false>(a, M_log2, conv);
+
+	const T scale = T(1) / T(M);
+	for (size_t k = 0; k < N; ++k)
+		data[k] = a[k] * (is_fwd ? std::conj(chirp[k]) : chirp[k]) * scale;
+}
+
+
+// four-step initialization
+/*
+		The N = N1*N2, where N1 is the largest divisor
+	not greater than sqrt(N). The sub-tables are shared
+	through the registry.
+*/
+template<typename T>
+void DFT_Table<T>::init_four_step(size_type N)
+{
+	size_type N1 = 1;
+	for (size_type d = 2; d*d <= N; ++d)
+		if (0 == N%d) N1 = d;
+
+	if (1 == N1) // prime size
+	{
+		if (!fft_factorize(N, m_factors)
+			&& size_type(BLUESTEIN_MIN) <= N)
+				init_bluestein(N);
+		return;
+	}
+
+	const size_type N2 = N/N1;
+
+	m_rows = N1;
+	m_sub1 = dft_tables((T*)0).get(N1);
+	m_sub2 = dft_tables((T*)0).get(N2);
+}
+
+
+template<bool is_fwd, typename T>
+void dft_transform(std::complex<T> *data, size_t N_log2,
+	const DFT_Table<T> &phase, std::complex<T> *work);
+
+
+// @brief begin of the scratch buffer (0 if empty)
+template<typename T> inline
+T* dft_work(std::vector<T> &work)
+{
+	return work.empty() ? 0 : &work[0];
+}
+
+
+// @brief log2 of power of two size (0 otherwise)
+inline size_t dft_log2(size_t N)
+{
+	return omni::util::is_ipow2(N)
+		? omni::util::log2(N) : 0;
+}
+
+
+// @brief sub-transforms of the rows (parallel job)
+template<bool is_fwd, typename T>
+class DFT_RowsJob: public DFT_Job {
+public:
+	DFT_RowsJob(std::complex<T> *data, const DFT_Table<T> &phase)
+		: m_data(data), m_phase(phase),
+		  m_log2(dft_log2(phase.size()))
+	{}
+
+	virtual void run(size_t first, size_t last) const
+	{
+		const size_t N = m_phase.size();
+		std::vector< std::complex<T> > work(m_phase.work_size());
+		for (size_t i = first; i < last; ++i)
+			dft_transform<is_fwd>(m_data + i*N, m_log2, m_phase, dft_work(work));
+	}
+
+private:
+	std::complex<T> *m_data;
+	const DFT_Table<T> &m_phase;
+	size_t m_log2;
+};
+
+
+// @brief sub-transforms of the columns (parallel job)
+/*
+		The column j of the source matrix [rows x cols] is transformed
+	to the row j of the destination matrix [cols x rows]. The job
+	items are blocks of BLOCK columns: the block is gathered row by
+	row (contiguous reads) and transformed while it's in the cache.
+*/
+template<bool is_fwd, typename T>
+class DFT_ColumnsJob: public DFT_Job {
+public:
+	enum { BLOCK = 16 };
+
+	DFT_ColumnsJob(std::complex<T> *dst, const std::complex<T> *src,
+			size_t cols, const DFT_Table<T> &phase)
+		: m_dst(dst), m_src(src), m_cols(cols), m_phase(phase),
+		  m_log2(dft_log2(phase.size()))
+	{}
+
+	virtual void run(size_t first, size_t last) const
+	{
+		const size_t rows = m_phase.size();
+		std::vector< std::complex<T> > work(m_phase.work_size());
+
+		const size_t c_last = std::min(last*BLOCK, m_cols);
+		for (size_t c0 = first*BLOCK; c0 < c_last; c0 += BLOCK)
+		{
+			const size_t c1 = std::min(c0 + BLOCK, m_cols);
+
+			for (size_t r = 0; r < rows; ++r)
+			for (size_t c = c0; c < c1; ++c)
+				m_dst[c*rows + r] = m_src[r*m_cols + c];
+
+			for (size_t c = c0; c < c1; ++c)
+				dft_transform<is_fwd>(m_dst + c*rows, m_log2, m_phase, dft_work(work));
+		}
+	}
+
+	// number of job items
+	size_t count() const
+	{
+		return (m_cols + BLOCK-1) / BLOCK;
+	}
+
+private:
+	std::complex<T> *m_dst;
+	const std::complex<T> *m_src;
+	size_t m_cols;
+	const DFT_Table<T> &m_phase;
+	size_t m_log2;
+};
+
+
+// @brief blocked in-place transpose of square matrix (parallel job)
+/*
+		The job items are blocks of BLOCK rows. The blocks
+	above diagonal are swapped with the blocks below.
+*/
+template<typename T>
+class DFT_SquareJob: public DFT_Job {
+public:
+	enum { BLOCK = 16 };
+
+	DFT_SquareJob(std::complex<T> *data, size_t N)
+		: m_data(data), m_N(N)
+	{}
+
+	virtual void run(size_t first, size_t last) const
+	{
+		const size_t r_last = std::min(last*BLOCK, m_N);
+		for (size_t r0 = first*BLOCK; r0 < r_last; r0 += BLOCK)
+		for (size_t c0 = r0; c0 < m_N; c0 += BLOCK)
+		{
+			const size_t r1 = std::min(r0 + BLOCK, m_N);
+			const size_t c1 = std::min(c0 + BLOCK, m_N);
+
+			for (size_t r = r0; r < r1; ++r)
+			for (size_t c = (c0 == r0 ? r+1 : c0); c < c1; ++c)
+				std::swap(m_data[r*m_N + c], m_data[c*m_N + r]);
+		}
+	}
+
+	// number of job items
+	size_t count() const
+	{
+		return (m_N + BLOCK-1) / BLOCK;
+	}
+
+private:
+	std::complex<T> *m_data;
+	size_t m_N;
+};
+
+
+// @brief blocked transpose (parallel job)
+/*
+		The source matrix [rows x cols] is transposed to the
+	destination matrix [cols x rows]. If the roots of unity W are
+	provided the item (r, c) is multiplied by W^(r*c), the index r*c
+	is less than rows*cols, i.e. the table size of the whole transform.
+	The job items are blocks of BLOCK rows.
+*/
+template<bool is_fwd, typename T>
+class DFT_TransposeJob: public DFT_Job {
+public:
+	enum { BLOCK = 16 };
+
+	DFT_TransposeJob(std::complex<T> *dst, const std::complex<T> *src,
+			size_t rows, size_t cols, const std::complex<T> *tw)
+		: m_dst(dst), m_src(src), m_rows(rows),
+		  m_cols(cols), m_tw(tw)
+	{}
+
+	virtual void run(size_t first, size_t last) const
+	{
+		const size_t r_last = std::min(last*BLOCK, m_rows);
+		for (size_t r0 = first*BLOCK; r0 < r_last; r0 += BLOCK)
+		for (size_t c0 = 0; c0 < m_cols; c0 += BLOCK)
+		{
+			const size_t r1 = std::min(r0 + BLOCK, m_rows);
+			const size_t c1 = std::min(c0 + BLOCK, m_cols);
+
+			if (m_tw)
+			{
+				for (size_t r = r0; r < r1; ++r)
+				for (size_t c = c0; c < c1; ++c)
+				{
+					const std::complex<T> w = m_tw[r*c];
+					m_dst[c*m_rows + r] = m_src[r*m_cols + c]
+						* (is_fwd ? std::conj(w) : w);
+				}
+			}
+			else
+			{
+				for (size_t r = r0; r < r1; ++r)
+				for (size_t c = c0; c < c1; ++c)
+					m_dst[c*m_rows + r] = m_src[r*m_cols + c];
+			}
+		}
+	}
+
+	// number of job items
+	size_t count() const
+	{
+		return (m_rows + BLOCK-1) / BLOCK;
+	}
+
+private:
+	std::complex<T> *m_dst;
+	const std::complex<T> *m_src;
+	size_t m_rows;
+	size_t m_cols;
+	const std::complex<T> *m_tw;
+};
+
+
+// @brief four-step algorithm
+/*
+		The input x[N2*n1 + n2] is considered as N1 x N2 matrix:
+
+	1. N2 transforms of size N1 (columns) to N2 x N1 matrix,
+	2. multiply by W^(n2*k1) and transpose to N1 x N2 matrix,
+	3. N1 transforms of size N2 (rows),
+	4. transpose to N2 x N1 matrix: X[k1 + N1*k2].
+
+		All steps work with the blocks that fit the cache and
+	run in parallel. The last transpose is in-place for square
+	matrix (N1 == N2). The @a tmp is the scratch buffer of N items.
+*/
+template<bool is_fwd, typename T>
+void fft_four_step(std::complex<T> *data, const DFT_Table<T> &phase, std::complex<T> *tmp)
+{
+	typedef DFT_TransposeJob<is_fwd, T> Transpose;
+
+	const size_t N = phase.size();
+	const size_t N1 = phase.rows();
+	const size_t N2 = N / N1;
+
+	const DFT_ColumnsJob<is_fwd, T> cols(tmp, data, N2, *phase.sub1());
+	dft_parallel(cols, cols.count(), DFT_ColumnsJob<is_fwd, T>::BLOCK*N1);
+
+	const Transpose t1(data, tmp, N2, N1, &phase[0]);
+	dft_parallel(t1, t1.count(), Transpose::BLOCK*N1);
+
+	dft_parallel(DFT_RowsJob<is_fwd, T>(data, *phase.sub2()), N1, N2);
+
+	if (N1 == N2)
+	{
+		const DFT_SquareJob<T> t2(data, N1);
+		dft_parallel(t2, t2.count(), DFT_SquareJob<T>::BLOCK*N1);
+	}
+	else
+	{
+		const Transpose t2(tmp, data, N1, N2, 0);
+		dft_parallel(t2, t2.count(), Transpose::BLOCK*N2);
+		std::copy(tmp, tmp+N, data);
+	}
+}
+
+
+// @brief transform without normalizing
+/*
+		The algorithm is selected by the table's plan:
+	radix-4, four-step, mixed-radix, Bluestein or direct DFT.
+	The @a work is the scratch buffer of phase.work_size() items,
+	so the repeated transforms don't allocate memory.
+*/
+template<bool is_fwd, typename T>
+void dft_transform(std::complex<T> *data, size_t N_log2,
+	const DFT_Table<T> &phase, std::complex<T> *work)
+{
+	const size_t N = phase.size();
+
+	if (N_log2 && phase.stages())
+	{
+		fft_reordering(data, N);
+		fft_radix4<is_fwd>(data, N_log2, phase);
+	}
+	else if (phase.rows())
+		fft_four_step<is_fwd>(data, phase, work);
+	else if (!phase.factors().empty())
+	{
+		std::copy(data, data+N, work);
+		fft_mixed<is_fwd>(data, work, 1, 1,
+			&phase.factors()[0], phase);
+	}
+	else if (phase.conv())
+		bluestein_algorithm<is_fwd>(data, N, phase, work);
+	else
+		dft_algorithm<is_fwd>(data, N, phase, work);
+}
+
+
+// @brief out-of-place transform without normalizing
+/*
+		The strided input is transformed to the contiguous output.
+	The input copy is fused with the bit-reversal reordering
+	for power of two sizes and with the first mixed-radix pass
+	for 2,3,5,7-smooth sizes.
+*/
+template<bool is_fwd, typename T>
+void dft_transform(std::complex<T> *out, const std::complex<T> *x,
+	ptrdiff_t stride, size_t N_log2, const DFT_Table<T> &phase,
+	std::complex<T> *work)
+{
+	const size_t N = phase.size();
+
+	if (N_log2 && phase.stages())
+	{
+		fft_reordering(out, x, stride, N);
+		fft_radix4<is_fwd>(out, N_log2, phase);
+	}
+	else if (!phase.factors().empty())
+	{
+		fft_mixed<is_fwd>(out, x, 1, stride,
+			&phase.factors()[0], phase);
+	}
+	else
+	{
+		for (size_t i = 0; i < N; ++i)
+			out[i] = x[ptrdiff_t(i)*stride];
+		dft_transform<is_fwd>(out, N_log2, phase, work);
+	}
+}
+
+
+// @brief the default plan
+DFT_Plan dft_estimate(size_t N)
+{
+	std::vector<size_t> factors;
+
+#if OMNI_MT
+	// four-step is faster only if it runs in parallel
+	if (size_t(FOUR_STEP_MIN) <= N && omni::util::is_ipow2(N) && 1 < dft_cpus())
+		return PLAN_FOUR_STEP;
+#endif // OMNI_MT
+
+	if (omni::util::is_ipow2(N))
+		return PLAN_RADIX4;
+	else if (fft_factorize(N, factors))
+		return PLAN_MIXED;
+	else if (size_t(BLUESTEIN_MIN) <= N)
+		return PLAN_BLUESTEIN;
+	else
+		return PLAN_DIRECT;
+}
+
+
+// @brief benchmark the plan
+/*
+		Returns the average time of one forward transform
+	in clock ticks. The transform is repeated at least 20 ms.
+*/
+template<typename T>
+double dft_measure(size_t N, DFT_Plan plan)
+{
+	const DFT_Table<T> table(N, plan);
+	const size_t N_log2 = (PLAN_RADIX4 == plan)
+		? omni::util::log2(N) : 0;
+
+	std::vector< std::complex<T> > data(N);
+	std::vector< std::complex<T> > work(table.work_size());
+	dft_transform<true>(&data[0], N_log2, table, dft_work(work)); // warm up
+
+	const clock_t start = clock();
+	clock_t stop = start;
+	size_t N_runs = 0;
+
+	do {
+		for (size_t i = 0; i < 4; ++i)
+			dft_transform<true>(&data[0], N_log2, table, dft_work(work));
+		N_runs += 4;
+
+		stop = clock();
+	} while (stop - start < CLOCKS_PER_SEC/50);
+
+	return double(stop - start) / N_runs;
+}
+
+
+// @brief is the plan suitable for the size?
+bool dft_plan_valid(size_t N, DFT_Plan plan)
+{
+	std::vector<size_t> factors;
+
+	switch (plan)
+	{
+		case PLAN_RADIX4:    return 1 < N && omni::util::is_ipow2(N);
+		case PLAN_MIXED:     return 1 < N && fft_factorize(N, factors);
+		case PLAN_BLUESTEIN: return size_t(BLUESTEIN_MIN) <= N && !omni::util::is_ipow2(N);
+		case PLAN_DIRECT:    return 0 < N;
+		case PLAN_FOUR_STEP: return 1 < N;
+		default:             return false;
+	}
+}
+
+
+// @brief select the fastest plan
+/*
+		The direct DFT is measured for small sizes only,
+	the four-step algorithm for large sizes only.
+*/
+template<typename T>
+DFT_Plan dft_measure_best(size_t N)
+{
+	enum { DIRECT_MAX = 256 };
+	enum { FOUR_STEP_MEASURE = 1<<12 };
+
+	DFT_Plan plans[5];
+	size_t N_plans = 0;
+
+	for (size_t k = PLAN_RADIX4; k <= PLAN_FOUR_STEP; ++k)
+	{
+		if (!dft_plan_valid(N, DFT_Plan(k)))
+			continue;
+		if (PLAN_DIRECT == k && size_t(DIRECT_MAX) < N)
+			continue;
+		if (PLAN_FOUR_STEP == k && N < size_t(FOUR_STEP_MEASURE))
+			continue;
+
+		plans[N_plans++] = DFT_Plan(k);
+	}
+
+	if (N_plans < 2)
+		return dft_estimate(N);
+
+	DFT_Plan best = plans[0];
+	double best_time = dft_measure<T>(N, best);
+	for (size_t i = 1; i < N_plans; ++i)
+	{
+		const double t = dft_measure<T>(N, plans[i]);
+		if (t < best_time)
+		{
+			best_time = t;
+			best = plans[i];
+		}
+	}
+
+	return best;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// planner synchronization
+#if OMNI_MT
+	CriticalSection& dft_plan_lock()
+	{
+		static CriticalSection LOCK;
+		return LOCK;
+	}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// planner mode
+volatile long& dft_plan_mode()
+{
+	static volatile long MODE = DFT_Planner::ESTIMATE;
+	return MODE;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// planner epoch
+volatile long& dft_plan_epoch()
+{
+	static volatile long EPOCH = 0;
+	return EPOCH;
+}
+
+// the planner is changed: cached tables should be found again
+void dft_plan_changed()
+{
+#if OMNI_MT
+	InterlockedIncrement(&dft_plan_epoch());
+#else
+	dft_plan_epoch() += 1;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// measured plans: size => plan
+template<typename T>
+	std::map<size_t, DFT_Plan>& dft_wisdom(const T* = 0) // avoid VC6 bug
+{
+	static std::map<size_t, DFT_Plan> WISDOM;
+	return WISDOM;
+}
+
+
+// @brief the transform plan
+/*
+		The wisdom is used first. In measure mode the missing
+	plan is measured and saved to the wisdom.
+*/
+template<typename T>
+DFT_Plan dft_plan(const T*, size_t N)
+{
+	OMNI_MT_CODE(AutoLock guard(dft_plan_lock()));
+	std::map<size_t, DFT_Plan> &wisdom = dft_wisdom((T*)0);
+
+	typename std::map<size_t, DFT_Plan>::const_iterator found = wisdom.find(N);
+	if (found != wisdom.end())
+		return found->second;
+
+	if (DFT_Planner::MEASURE != dft_plan_mode())
+		return PLAN_ESTIMATE;
+
+	return (wisdom[N] = dft_measure_best<T>(N));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// plan names (wisdom)
+const char* const PLAN_NAMES[] = { "estimate",
+	"radix4", "mixed", "bluestein", "direct", "fourstep" };
+
+// convert ASCII string
+template<typename Str>
+Str dft_widen(const char *s)
+{
+	return Str(s, s + strlen(s));
+}
+
+// convert to ASCII string
+template<typename Str>
+std::string dft_narrow(const Str &s)
+{
+	std::string out(s.size(), ' ');
+	for (size_t i = 0; i < s.size(); ++i)
+		out[i] = char(s[i]);
+
+	return out;
+}
+
+
+// @brief export the wisdom of one type
+/*
+		The wisdom has the following format:
+
+	<double>
+		1536 = "mixed"
+		1999 = "bluestein"
+	</double>
+*/
+template<typename T, typename Str>
+void dft_export(conf::ItemT<Str> &wisdom, const char *type)
+{
+	OMNI_MT_CODE(AutoLock guard(dft_plan_lock()));
+	const std::map<size_t, DFT_Plan> &plans = dft_wisdom((T*)0);
+
+	conf::ItemT<Str> &item = wisdom.get(dft_widen<Str>(type), true);
+	item.clear();
+
+	typename std::map<size_t, DFT_Plan>::const_iterator i = plans.begin();
+	for (; i != plans.end(); ++i)
+	{
+		char name[32];
+		sprintf(name, "%lu", (unsigned long)i->first);
+		item.push_back(dft_widen<Str>(name))
+			= dft_widen<Str>(PLAN_NAMES[i->second]);
+	}
+}
+
+
+// @brief import the wisdom of one type
+/*
+		The unknown plans and the plans not suitable for
+	the size (see dft_plan_valid()) are ignored.
+*/
+template<typename T, typename Str>
+void dft_import(const conf::ItemT<Str> &wisdom, const char *type)
+{
+	const Str type_name = dft_widen<Str>(type);
+	if (!wisdom.exists(type_name))
+		return;
+
+	OMNI_MT_CODE(AutoLock guard(dft_plan_lock()));
+	std::map<size_t, DFT_Plan> &plans = dft_wisdom((T*)0);
+
+	const conf::ItemT<Str> &item = wisdom.get(type_name);
+	typename conf::ItemT<Str>::ConstIterator i = item.begin();
+	for (; i != item.end(); ++i)
+	{
+		const size_t N = strtoul(dft_narrow(i->name()).c_str(), 0, 10);
+		const std::string plan = dft_narrow(i->val());
+
+		for (size_t k = PLAN_RADIX4; k <= PLAN_FOUR_STEP; ++k)
+			if (plan == PLAN_NAMES[k] && dft_plan_valid(N, DFT_Plan(k)))
+				plans[N] = DFT_Plan(k);
+	}
+
+	dft_plan_changed();
+}
+
+
+// @brief clear the wisdom of one type
+template<typename T>
+void dft_clear()
+{
+	OMNI_MT_CODE(AutoLock guard(dft_plan_lock()));
+	dft_wisdom((T*)0).clear();
+	dft_plan_changed();
+}
+
+} // details namespace
+#endif // !OMNI_USE_MKL
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT planner
+#if !defined(OMNI_USE_MKL)
+
+void DFT_Planner::set_mode(Mode mode)
+{
+	details::dft_plan_mode() = mode;
+	details::dft_plan_changed();
+}
+
+DFT_Planner::Mode DFT_Planner::mode()
+{
+	return Mode(details::dft_plan_mode());
+}
+
+void DFT_Planner::export_wisdom(conf::ItemT<std::string> &wisdom)
+{
+	details::dft_export<double>(wisdom, "double");
+	details::dft_export<float>(wisdom, "float");
+}
+
+void DFT_Planner::export_wisdom(conf::ItemT<std::wstring> &wisdom)
+{
+	details::dft_export<double>(wisdom, "double");
+	details::dft_export<float>(wisdom, "float");
+}
+
+void DFT_Planner::import_wisdom(const conf::ItemT<std::string> &wisdom)
+{
+	details::dft_import<double>(wisdom, "double");
+	details::dft_import<float>(wisdom, "float");
+}
+
+void DFT_Planner::import_wisdom(const conf::ItemT<std::wstring> &wisdom)
+{
+	details::dft_import<double>(wisdom, "double");
+	details::dft_import<float>(wisdom, "float");
+}
+
+void DFT_Planner::clear_wisdom()
+{
+	details::dft_clear<double>();
+	details::dft_clear<float>();
+}
+
+#else // OMNI_USE_MKL
+
+// MKL makes its own plans
+void DFT_Planner::set_mode(Mode) {}
+DFT_Planner::Mode DFT_Planner::mode() { return ESTIMATE; }
+void DFT_Planner::export_wisdom(conf::ItemT<std::string>&) {}
+void DFT_Planner::export_wisdom(conf::ItemT<std::wstring>&) {}
+void DFT_Planner::import_wisdom(const conf::ItemT<std::string>&) {}
+void DFT_Planner::import_wisdom(const conf::ItemT<std::wstring>&) {}
+void DFT_Planner::clear_wisdom() {}
+
+#endif // OMNI_USE_MKL
+
+
+#if defined(OMNI_USE_MKL)
+
+//////////////////////////////////////////////////////////////////////////
+// DFT initialization
+template<typename T>
+void DFT<T>::init()
+{
+	// create descriptor
+	long ret = DftiCreateDescriptor((DFTI_DESCRIPTOR_HANDLE*)&m_impl,
+		sizeof(T) < sizeof(double) ? DFTI_SINGLE:DFTI_DOUBLE,
+			DFTI_COMPLEX, 1, m_size);
+	assert(DFTI_NO_ERROR==ret && "DFTI descriptor creation");
+
+	// set forward scale
+	ret = DftiSetValue((DFTI_DESCRIPTOR_HANDLE)m_impl, DFTI_FORWARD_SCALE, m_fwd_scale);
+	assert(DFTI_NO_ERROR==ret && "set DFTI forward scale");
+
+	// set inverse scale
+	ret = DftiSetValue((DFTI_DESCRIPTOR_HANDLE)m_impl, DFTI_BACKWARD_SCALE, m_inv_scale);
+	assert(DFTI_NO_ERROR==ret && "set DFTI backward scale");
+
+	// commit descriptor
+	ret = DftiCommitDescriptor((DFTI_DESCRIPTOR_HANDLE)m_impl);
+	assert(DFTI_NO_ERROR==ret && "DFTI descriptor commit");
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT destruction
+template<typename T>
+DFT<T>::~DFT()
+{
+	// release descriptor
+	long ret = DftiFreeDescriptor((DFTI_DESCRIPTOR_HANDLE*)&m_impl);
+	ret; assert(DFTI_NO_ERROR==ret && "DFTI descriptor destruction");
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// forward transform
+template<typename T>
+void DFT<T>::forward(value_type *data)
 {
 	long ret = DftiComputeForward((DFTI_DESCRIPTOR_HANDLE)m_impl, data);
 	ret; assert(DFTI_NO_ERROR==ret && "DFTI forward transform");
@@ -305,151 +1984,900 @@ void DFT<T>::forward(value_type *data)
 
 
 //////////////////////////////////////////////////////////////////////////
-// inverse transform
+// inverse transform
+template<typename T>
+void DFT<T>::inverse(value_type *data)
+{
+	long ret = DftiComputeBackward((DFTI_DESCRIPTOR_HANDLE)m_impl, data);
+	ret; assert(DFTI_NO_ERROR==ret && "DFTI backward transform");
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// out-of-place forward transform
+template<typename T>
+void DFT<T>::forward(const value_type *x, difference_type x_stride,
+	value_type *y, difference_type y_stride)
+{
+	// the descriptor is committed for in-place transforms
+	std::vector<value_type> tmp(m_size);
+	for (size_type i = 0; i < m_size; ++i)
+		tmp[i] = x[difference_type(i)*x_stride];
+
+	forward(&tmp[0]);
+
+	for (size_type i = 0; i < m_size; ++i)
+		y[difference_type(i)*y_stride] = tmp[i];
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// out-of-place inverse transform
+template<typename T>
+void DFT<T>::inverse(const value_type *x, difference_type x_stride,
+	value_type *y, difference_type y_stride)
+{
+	// the descriptor is committed for in-place transforms
+	std::vector<value_type> tmp(m_size);
+	for (size_type i = 0; i < m_size; ++i)
+		tmp[i] = x[difference_type(i)*x_stride];
+
+	inverse(&tmp[0]);
+
+	for (size_type i = 0; i < m_size; ++i)
+		y[difference_type(i)*y_stride] = tmp[i];
+}
+
+#else // OMNI_USE_MKL
+
+//////////////////////////////////////////////////////////////////////////
+// DFT initialization
+template<typename T>
+void DFT<T>::init()
+{
+	// get table (lock-free)
+	const details::DFT_Table<T> *table = details::dft_tables((T*)0).get(m_size);
+	m_impl = const_cast<details::DFT_Table<T>*>(table);
+	m_work.resize(table->work_size());
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT destruction
+template<typename T>
+DFT<T>::~DFT()
+{
+	// the table is owned by registry
+}
+
+//////////////////////////////////////////////////////////////////////////
+// forward transform
+template<typename T>
+void DFT<T>::forward(value_type *data)
+{
+	typedef details::DFT_Table<T> table_type;
+
+	details::dft_transform<true>(data, m_log2,
+		*(table_type*)m_impl, details::dft_work(m_work));
+
+	// normalizing
+	if (m_fwd_scale != scalar_type(1))
+	for (size_t i = 0; i < m_size; ++i)
+		data[i] *= m_fwd_scale;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// inverse transform
+template<typename T>
+void DFT<T>::inverse(value_type *data)
+{
+	typedef details::DFT_Table<T> table_type;
+
+	details::dft_transform<false>(data, m_log2,
+		*(table_type*)m_impl, details::dft_work(m_work));
+
+	// normalizing
+	if (m_inv_scale != scalar_type(1))
+	for (size_t i = 0; i < m_size; ++i)
+		data[i] *= m_inv_scale;
+}
+
+
+namespace details
+{
+
+// @brief out-of-place transform
+/*
+		The contiguous output is transformed directly,
+	the strided output uses temporary buffer.
+*/
+template<bool is_fwd, typename T>
+void dft_strided(const std::complex<T> *x, ptrdiff_t x_stride,
+	std::complex<T> *y, ptrdiff_t y_stride, T scale,
+	size_t N_log2, const DFT_Table<T> &phase, std::complex<T> *work)
+{
+	const size_t N = phase.size();
+
+	if (1 == y_stride)
+	{
+		dft_transform<is_fwd>(y, x, x_stride, N_log2, phase, work);
+
+		// normalizing
+		if (scale != T(1))
+		for (size_t i = 0; i < N; ++i)
+			y[i] *= scale;
+	}
+	else
+	{
+		std::vector< std::complex<T> > tmp(N);
+		dft_transform<is_fwd>(&tmp[0], x, x_stride, N_log2, phase, work);
+
+		// normalizing
+		for (size_t i = 0; i < N; ++i)
+			y[ptrdiff_t(i)*y_stride] = tmp[i] * scale;
+	}
+}
+
+} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// out-of-place forward transform
+template<typename T>
+void DFT<T>::forward(const value_type *x, difference_type x_stride,
+	value_type *y, difference_type y_stride)
+{
+	typedef details::DFT_Table<T> table_type;
+
+	details::dft_strided<true>(x, x_stride, y, y_stride,
+		m_fwd_scale, m_log2, *(table_type*)m_impl,
+		details::dft_work(m_work));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// out-of-place inverse transform
+template<typename T>
+void DFT<T>::inverse(const value_type *x, difference_type x_stride,
+	value_type *y, difference_type y_stride)
+{
+	typedef details::DFT_Table<T> table_type;
+
+	details::dft_strided<false>(x, x_stride, y, y_stride,
+		m_inv_scale, m_log2, *(table_type*)m_impl,
+		details::dft_work(m_work));
+}
+
+#endif // OMNI_USE_MKL
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT construction
+template<typename T>
+DFT<T>::DFT(size_type DFT_size)
+	: m_fwd_scale(scalar_type(1)/DFT_size), m_inv_scale(1), m_size(DFT_size)
+{
+	using namespace omni::util;
+
+	m_log2 = (is_ipow2(DFT_size))
+		? log2(DFT_size) : 0;
+
+	init();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT construction
+template<typename T>
+DFT<T>::DFT(size_type DFT_size, scalar_type fwd_scale, scalar_type inv_scale)
+	: m_fwd_scale(fwd_scale), m_inv_scale(inv_scale), m_size(DFT_size)
+{
+	using namespace omni::util;
+
+	m_log2 = (is_ipow2(DFT_size))
+		? log2(DFT_size) : 0;
+
+	init();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT copy construction
+template<typename T>
+DFT<T>::DFT(const this_type &x)
+	: m_fwd_scale(x.m_fwd_scale), m_inv_scale(x.m_inv_scale),
+	  m_size(x.m_size), m_log2(x.m_log2)
+{
+	init();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT assignment
+template<typename T>
+typename DFT<T>::this_type& DFT<T>::operator=(const this_type &x)
+{
+	this_type t(x);
+	swap(t);
+
+	return *this;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// swap two DFT
+template<typename T>
+void DFT<T>::swap(this_type &x)
+{
+	std::swap(m_fwd_scale, x.m_fwd_scale);
+	std::swap(m_inv_scale, x.m_inv_scale);
+
+	std::swap(m_size, x.m_size);
+	std::swap(m_log2, x.m_log2);
+	std::swap(m_impl, x.m_impl);
+	m_work.swap(x.m_work);
+}
+
+
+namespace details
+{
+
+// @brief batch of transforms
+template<typename T>
+class DFT_Batch: public DFT_Job {
+public:
+	DFT_Batch(DFT<T> &dft, std::complex<T> *data, size_t distance, bool is_fwd)
+		: m_dft(&dft), m_data(data), m_distance(distance), m_is_fwd(is_fwd)
+	{}
+
+	virtual void run(size_t first, size_t last) const
+	{
+		DFT<T> dft(*m_dft); // own scratch buffer per thread
+
+		for (size_t i = first; i < last; ++i)
+		{
+			if (m_is_fwd)
+				dft.forward(m_data + i*m_distance);
+			else
+				dft.inverse(m_data + i*m_distance);
+		}
+	}
+
+private:
+	DFT<T> *m_dft;
+	std::complex<T> *m_data;
+	size_t m_distance;
+	bool m_is_fwd;
+};
+
+
+// @brief batched transform
+/*
+		The transform table is shared by all threads (read only).
+*/
+template<typename T>
+void dft_batch(DFT<T> &dft, std::complex<T> *data,
+	size_t count, size_t distance, bool is_fwd)
+{
+	dft_parallel(DFT_Batch<T>(dft, data, distance, is_fwd),
+		count, dft.size());
+}
+
+} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// batched forward transform
+template<typename T>
+void DFT<T>::forward_batch(value_type *data, size_type count, size_type distance)
+{
+	assert(size() <= distance && "invalid batch distance");
+	details::dft_batch(*this, data, count, distance, true);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// batched inverse transform
+template<typename T>
+void DFT<T>::inverse_batch(value_type *data, size_type count, size_type distance)
+{
+	assert(size() <= distance && "invalid batch distance");
+	details::dft_batch(*this, data, count, distance, false);
+}
+
+
+namespace details
+{
+
+// @brief strided transforms of 2-D DFT (parallel job)
+/*
+		The job items are blocks of BLOCK strided vectors. The block is
+	gathered (contiguous reads) to the buffer, transformed and
+	scattered back.
+*/
+template<typename T>
+class DFT_Strided2D: public DFT_Job {
+public:
+	enum { BLOCK = 16 };
+
+	DFT_Strided2D(DFT<T> &dft, std::complex<T> *data, size_t stride, bool is_fwd)
+		: m_dft(&dft), m_data(data), m_stride(stride), m_is_fwd(is_fwd)
+	{}
+
+	virtual void run(size_t first, size_t last) const
+	{
+		const size_t N = m_dft->size();
+		std::vector< std::complex<T> > buf(BLOCK*N);
+		DFT<T> dft(*m_dft); // own scratch buffer per thread
+
+		const size_t j_last = std::min(last*BLOCK, m_stride);
+		for (size_t j0 = first*BLOCK; j0 < j_last; j0 += BLOCK)
+		{
+			const size_t nj = std::min(size_t(BLOCK), m_stride - j0);
+
+			for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < nj; ++j)
+				buf[j*N + i] = m_data[i*m_stride + j0 + j];
+
+			for (size_t j = 0; j < nj; ++j)
+			{
+				if (m_is_fwd)
+					dft.forward(&buf[j*N]);
+				else
+					dft.inverse(&buf[j*N]);
+			}
+
+			for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < nj; ++j)
+				m_data[i*m_stride + j0 + j] = buf[j*N + i];
+		}
+	}
+
+	// number of job items
+	size_t count() const
+	{
+		return (m_stride + BLOCK-1) / BLOCK;
+	}
+
+private:
+	DFT<T> *m_dft;
+	std::complex<T> *m_data;
+	size_t m_stride;
+	bool m_is_fwd;
+};
+
+} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// 2-D DFT construction
 template<typename T>
-void DFT<T>::inverse(value_type *data)
+DFT2D<T>::DFT2D(size_type N_rows, size_type N_cols)
+#if OMNI_MATRIX_ROW_MAJOR
+	: m_inner(N_cols, scalar_type(1)/(N_rows*N_cols), scalar_type(1)),
+	  m_outer(N_rows, scalar_type(1), scalar_type(1))
+#else
+	: m_inner(N_rows, scalar_type(1)/(N_rows*N_cols), scalar_type(1)),
+	  m_outer(N_cols, scalar_type(1), scalar_type(1))
+#endif
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+// 2-D DFT construction
+template<typename T>
+DFT2D<T>::DFT2D(size_type N_rows, size_type N_cols, scalar_type fwd_scale, scalar_type inv_scale)
+#if OMNI_MATRIX_ROW_MAJOR
+	: m_inner(N_cols, fwd_scale, inv_scale),
+	  m_outer(N_rows, scalar_type(1), scalar_type(1))
+#else
+	: m_inner(N_rows, fwd_scale, inv_scale),
+	  m_outer(N_cols, scalar_type(1), scalar_type(1))
+#endif
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+// 2-D forward transform
+template<typename T>
+void DFT2D<T>::forward(value_type *data)
 {
-	long ret = DftiComputeBackward((DFTI_DESCRIPTOR_HANDLE)m_impl, data);
-	ret; assert(DFTI_NO_ERROR==ret && "DFTI backward transform");
+	const size_t N = m_inner.size();
+	m_inner.forward_batch(data, m_outer.size(), N);
+
+	const details::DFT_Strided2D<T> job(m_outer, data, N, true);
+	details::dft_parallel(job, job.count(),
+		details::DFT_Strided2D<T>::BLOCK*m_outer.size());
 }
 
-#else // OMNI_USE_MKL
 
 //////////////////////////////////////////////////////////////////////////
-// DFT initialization
+// 2-D inverse transform
 template<typename T>
-void DFT<T>::init()
+void DFT2D<T>::inverse(value_type *data)
 {
-	// get table
-	OMNI_MT_CODE(AutoLock guard(details::dft_lock()));
-	m_impl = details::dft_tables((T*)0).get(m_size);
+	const size_t N = m_inner.size();
+	m_inner.inverse_batch(data, m_outer.size(), N);
+
+	const details::DFT_Strided2D<T> job(m_outer, data, N, false);
+	details::dft_parallel(job, job.count(),
+		details::DFT_Strided2D<T>::BLOCK*m_outer.size());
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-// DFT destruction
+// real DFT construction
 template<typename T>
-DFT<T>::~DFT()
+RDFT<T>::RDFT(size_type DFT_size)
+	: m_fwd_scale(scalar_type(1)/DFT_size), m_inv_scale(1), m_size(DFT_size),
+	  m_half(DFT_size%2 ? DFT_size : DFT_size/2, scalar_type(1), scalar_type(1))
 {
-	// release table
-	OMNI_MT_CODE(AutoLock guard(details::dft_lock()));
-	details::dft_tables((T*)0).put((details::DFT_Table<T>*)m_impl);
+	init();
 }
 
+
 //////////////////////////////////////////////////////////////////////////
-// forward transform
+// real DFT construction
 template<typename T>
-void DFT<T>::forward(value_type *data)
+RDFT<T>::RDFT(size_type DFT_size, scalar_type fwd_scale, scalar_type inv_scale)
+	: m_fwd_scale(fwd_scale), m_inv_scale(inv_scale), m_size(DFT_size),
+	  m_half(DFT_size%2 ? DFT_size : DFT_size/2, scalar_type(1), scalar_type(1))
 {
-	typedef details::DFT_Table<T> table_type;
+	init();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// real DFT initialization
+template<typename T>
+void RDFT<T>::init()
+{
+	assert(0 < m_size && "invalid DFT size");
 
-	if (m_log2)
+	// twiddles: exp(-2*pi*i*k/N), k <= N/4
+	if (0 == m_size%2)
 	{
-		details::fft_reordering(data, m_size);
-		details::fft_algorithm<true>(data,
-			m_log2, *(table_type*)m_impl);
+		const size_type M = m_size/2;
+		m_twiddle.resize(M/2 + 1);
+		for (size_type k = 0; k < m_twiddle.size(); ++k)
+			m_twiddle[k] = value_type(std::polar(1.0,
+				-2*omni::util::PI * double(k) / double(m_size)));
 	}
-	else
-		details::dft_algorithm<true>(data,
-			m_size, *(table_type*)m_impl);
+}
 
-	// normalizing
-	if (m_fwd_scale != scalar_type(1))
-	for (size_t i = 0; i < m_size; ++i)
-		data[i] *= m_fwd_scale;
+
+//////////////////////////////////////////////////////////////////////////
+// real forward transform
+/*
+		The even and odd samples are packed into the N/2 complex
+	numbers z[k] = x[2k] + i*x[2k+1], the output buffer is used
+	as temporary. The spectrum is separated after transform:
+
+		X[k] = E[k] + W^k O[k],  X[M-k] = conj(E[k] - W^k O[k]),
+
+	where E[k] = (Z[k] + conj(Z[M-k]))/2, O[k] = -i(Z[k] - conj(Z[M-k]))/2.
+*/
+template<typename T>
+void RDFT<T>::forward(const scalar_type *x, value_type *y)
+{
+	if (m_size%2) // odd size: complex transform
+	{
+		std::vector<value_type> tmp(x, x + m_size);
+		m_half.forward(&tmp[0]);
+
+		for (size_type k = 0; k <= m_size/2; ++k)
+			y[k] = tmp[k] * m_fwd_scale;
+		return;
+	}
+
+	const size_type M = m_size/2;
+	for (size_type k = 0; k < M; ++k)
+		y[k] = value_type(x[2*k], x[2*k+1]);
+
+	m_half.forward(y);
+
+	// DC and Nyquist
+	const value_type z0 = y[0];
+	y[0] = value_type(z0.real() + z0.imag(), 0) * m_fwd_scale;
+	y[M] = value_type(z0.real() - z0.imag(), 0) * m_fwd_scale;
+
+	for (size_type k = 1; k <= M/2; ++k)
+	{
+		const value_type a = y[k];
+		const value_type b = std::conj(y[M-k]);
+
+		const value_type E = (a + b) * scalar_type(0.5);
+		const value_type D = (a - b) * scalar_type(0.5);
+		const value_type O(D.imag(), -D.real()); // -i*D
+		const value_type WO = m_twiddle[k] * O;
+
+		y[k] = (E + WO) * m_fwd_scale;
+		y[M-k] = std::conj(E - WO) * m_fwd_scale;
+	}
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-// inverse transform
+// real inverse transform
+/*
+		The even and odd spectra are combined into the N/2 complex
+	numbers Z[k] = E[k] + i*O[k], the output buffer is used as
+	temporary. The N/2 inverse complex transform gives the even
+	and odd samples as real and imaginary parts.
+*/
 template<typename T>
-void DFT<T>::inverse(value_type *data)
+void RDFT<T>::inverse(const value_type *y, scalar_type *x)
 {
-	typedef details::DFT_Table<T> table_type;
+	if (m_size%2) // odd size: complex transform
+	{
+		std::vector<value_type> tmp(m_size);
+		for (size_type k = 0; k <= m_size/2; ++k)
+		{
+			tmp[k] = y[k];
+			if (k)
+				tmp[m_size-k] = std::conj(y[k]);
+		}
+
+		m_half.inverse(&tmp[0]);
+
+		for (size_type i = 0; i < m_size; ++i)
+			x[i] = tmp[i].real() * m_inv_scale;
+		return;
+	}
 
-	if (m_log2)
+	const size_type M = m_size/2;
+	value_type *z = reinterpret_cast<value_type*>(x);
+
+	// DC and Nyquist
+	const scalar_type y0 = y[0].real();
+	const scalar_type yM = y[M].real();
+	z[0] = value_type(y0 + yM, y0 - yM);
+
+	for (size_type k = 1; k <= M/2; ++k)
 	{
-		details::fft_reordering(data, m_size);
-		details::fft_algorithm<false>(data,
-			m_log2, *(table_type*)m_impl);
+		const value_type a = y[k];
+		const value_type b = std::conj(y[M-k]);
+
+		const value_type E = a + b;
+		const value_type O = (a - b) * std::conj(m_twiddle[k]);
+
+		z[k] = E + value_type(-O.imag(), O.real());   // E + i*O
+		z[M-k] = std::conj(E - value_type(-O.imag(), O.real()));
 	}
-	else
-		details::dft_algorithm<false>(data,
-			m_size, *(table_type*)m_impl);
 
-	// normalizing
+	m_half.inverse(z);
+
 	if (m_inv_scale != scalar_type(1))
-	for (size_t i = 0; i < m_size; ++i)
-		data[i] *= m_inv_scale;
+	for (size_type i = 0; i < m_size; ++i)
+		x[i] *= m_inv_scale;
 }
 
-#endif // OMNI_USE_MKL
 
+namespace details
+{
+
+// @brief Q15 multiplication with rounding (as pmulhrsw)
+inline short fix_mulhrs(short a, short b)
+{
+	return short((int(a)*int(b) + 0x4000) >> 15);
+}
 
-//////////////////////////////////////////////////////////////////////////
-// DFT construction
-template<typename T>
-DFT<T>::DFT(size_type DFT_size)
-	: m_fwd_scale(scalar_type(1)/DFT_size), m_inv_scale(1), m_size(DFT_size)
+// @brief saturated addition (as paddsw)
+inline short fix_adds(int a, int b)
 {
-	using namespace omni::util;
+	const int x = a + b;
+	return short(x < -32768 ? -32768 : (32767 < x ? 32767 : x));
+}
 
-	m_log2 = (is_ipow2(DFT_size))
-		? log2(DFT_size) : 0;
+// @brief saturated absolute value
+inline int fix_abs(short a)
+{
+	return a < 0 ? (a == -32768 ? 32767 : -a) : a;
+}
 
-	init();
+// @brief block shift for the given maximum
+/*
+		The radix-2 butterfly output is bounded by (1 + sqrt(2))*max,
+	so the input should be less than 2^13.
+*/
+inline int fix_shift(int max_abs)
+{
+	return (16384 <= max_abs) ? 2
+		: ((8192 <= max_abs) ? 1 : 0);
 }
 
 
-//////////////////////////////////////////////////////////////////////////
-// DFT construction
-template<typename T>
-DFT<T>::DFT(size_type DFT_size, scalar_type fwd_scale, scalar_type inv_scale)
-	: m_fwd_scale(fwd_scale), m_inv_scale(inv_scale), m_size(DFT_size)
+// @brief radix-2 stage (general version)
+/*
+		The data is shifted right by @a shift bits and the stage
+	with the half-size @a h is applied. Returns the maximum
+	absolute value of output.
+*/
+template<bool is_fwd>
+int fix_stage_T(short *x, size_t N, size_t h,
+	const short *cc, const short *ss, int shift)
 {
-	using namespace omni::util;
+	int max_abs = 0;
 
-	m_log2 = (is_ipow2(DFT_size))
-		? log2(DFT_size) : 0;
+	for (size_t j = 0; j < N; j += 2*h)
+	for (size_t k = 0; k < h; ++k)
+	{
+		short *A = x + 2*(j+k);
+		short *B = A + 2*h;
 
-	init();
+		const short ar = short(A[0] >> shift), ai = short(A[1] >> shift);
+		const short br = short(B[0] >> shift), bi = short(B[1] >> shift);
+		const short c = cc[2*k];
+		const short s0 = is_fwd ? ss[2*k] : short(-ss[2*k]);
+		const short s1 = is_fwd ? ss[2*k+1] : short(-ss[2*k+1]);
+
+		const short tr = fix_adds(fix_mulhrs(br, c), fix_mulhrs(bi, s0));
+		const short ti = fix_adds(fix_mulhrs(bi, c), fix_mulhrs(br, s1));
+
+		A[0] = fix_adds(ar, tr); A[1] = fix_adds(ai, ti);
+		B[0] = fix_adds(ar, -tr); B[1] = fix_adds(ai, -ti);
+
+		max_abs = std::max(max_abs, std::max(
+			std::max(fix_abs(A[0]), fix_abs(A[1])),
+			std::max(fix_abs(B[0]), fix_abs(B[1]))));
+	}
+
+	return max_abs;
 }
 
 
-//////////////////////////////////////////////////////////////////////////
-// DFT copy construction
-template<typename T>
-DFT<T>::DFT(const this_type &x)
-	: m_fwd_scale(x.m_fwd_scale), m_inv_scale(x.m_inv_scale),
-	  m_size(x.m_size), m_log2(x.m_log2)
+// @brief radix-2 butterfly (SSSE3 version)
+/*
+		Four butterflies: the inputs are shifted right, the B input
+	is multiplied by twiddles { c, c } and { s, -s }. The maximum
+	absolute value of output is accumulated in @a m.
+*/
+DFT_SSSE3_TARGET inline
+void fix_butterfly_SSSE3(__m128i &a, __m128i &b, __m128i c,
+	__m128i s, __m128i count, __m128i &m)
 {
-	init();
+	const __m128i zero = _mm_setzero_si128();
+	a = _mm_sra_epi16(a, count);
+	b = _mm_sra_epi16(b, count);
+
+	// swap real and imaginary parts: { bi, br }
+	const __m128i b_swap = _mm_shufflehi_epi16(
+		_mm_shufflelo_epi16(b, 0xB1), 0xB1);
+
+	const __m128i t = _mm_adds_epi16(
+		_mm_mulhrs_epi16(b, c),
+		_mm_mulhrs_epi16(b_swap, s));
+
+	b = _mm_subs_epi16(a, t);
+	a = _mm_adds_epi16(a, t);
+
+	m = _mm_max_epi16(m, _mm_max_epi16(a, _mm_subs_epi16(zero, a)));
+	m = _mm_max_epi16(m, _mm_max_epi16(b, _mm_subs_epi16(zero, b)));
+}
+
+
+// @brief radix-2 stage (SSSE3 version)
+/*
+		Four complex samples per register. The first two stages
+	(h = 1, 2) are shuffled to get four butterflies per register.
+*/
+template<bool is_fwd> DFT_SSSE3_TARGET
+int fix_stage_SSSE3(short *x, size_t N, size_t h,
+	const short *cc, const short *ss, int shift)
+{
+	if (N < 8)
+		return fix_stage_T<is_fwd>(x, N, h, cc, ss, shift);
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	__m128i m = zero;
+
+	if (h < 4)
+	{
+		// twiddles for k < h (h = 1 or 2), repeated
+		__m128i c, s;
+		if (1 == h)
+		{
+			c = _mm_set1_epi32(*(const int*)cc);
+			s = _mm_set1_epi32(*(const int*)ss);
+		}
+		else
+		{
+			c = _mm_loadl_epi64((const __m128i*)cc);
+			s = _mm_loadl_epi64((const __m128i*)ss);
+			c = _mm_unpacklo_epi64(c, c);
+			s = _mm_unpacklo_epi64(s, s);
+		}
+		if (!is_fwd)
+			s = _mm_sub_epi16(zero, s);
+
+		for (size_t j = 0; j < N; j += 8)
+		{
+			__m128i *p0 = (__m128i*)(x + 2*j);
+			__m128i *p1 = p0 + 1;
+			__m128i r0 = _mm_loadu_si128(p0);
+			__m128i r1 = _mm_loadu_si128(p1);
+
+			if (1 == h) // { x0, x2, x1, x3 }
+			{
+				r0 = _mm_shuffle_epi32(r0, 0xD8);
+				r1 = _mm_shuffle_epi32(r1, 0xD8);
+			}
+
+			__m128i a = _mm_unpacklo_epi64(r0, r1);
+			__m128i b = _mm_unpackhi_epi64(r0, r1);
+			fix_butterfly_SSSE3(a, b, c, s, count, m);
+
+			if (1 == h)
+			{
+				r0 = _mm_unpacklo_epi32(a, b);
+				r1 = _mm_unpackhi_epi32(a, b);
+			}
+			else
+			{
+				r0 = _mm_unpacklo_epi64(a, b);
+				r1 = _mm_unpackhi_epi64(a, b);
+			}
+
+			_mm_storeu_si128(p0, r0);
+			_mm_storeu_si128(p1, r1);
+		}
+	}
+	else
+	{
+		for (size_t j = 0; j < N; j += 2*h)
+		for (size_t k = 0; k < h; k += 4)
+		{
+			__m128i *pa = (__m128i*)(x + 2*(j+k));
+			__m128i *pb = (__m128i*)(x + 2*(j+k+h));
+
+			__m128i a = _mm_loadu_si128(pa);
+			__m128i b = _mm_loadu_si128(pb);
+			const __m128i c = _mm_loadu_si128((const __m128i*)(cc + 2*k));
+			__m128i s = _mm_loadu_si128((const __m128i*)(ss + 2*k));
+			if (!is_fwd)
+				s = _mm_sub_epi16(zero, s);
+
+			fix_butterfly_SSSE3(a, b, c, s, count, m);
+			_mm_storeu_si128(pa, a);
+			_mm_storeu_si128(pb, b);
+		}
+	}
+
+	// horizontal maximum
+	m = _mm_max_epi16(m, _mm_shuffle_epi32(m, 0x4E));
+	m = _mm_max_epi16(m, _mm_shuffle_epi32(m, 0xB1));
+	m = _mm_max_epi16(m, _mm_shufflelo_epi16(m, 0xB1));
+	return _mm_cvtsi128_si32(m) & 0xFFFF;
+}
+
+
+// @brief radix-2 stage (general or SSSE3 version)
+/*
+		The @a ssse3 selects the SSSE3 version (should be supported
+	by processor). Used by unit test to compare both versions.
+*/
+int fix_stage(short *x, size_t N, size_t h, const short *cc,
+	const short *ss, int shift, bool is_fwd, bool ssse3)
+{
+	if (ssse3)
+	{
+		return is_fwd
+			? fix_stage_SSSE3<true>(x, N, h, cc, ss, shift)
+			: fix_stage_SSSE3<false>(x, N, h, cc, ss, shift);
+	}
+
+	return is_fwd
+		? fix_stage_T<true>(x, N, h, cc, ss, shift)
+		: fix_stage_T<false>(x, N, h, cc, ss, shift);
+}
+
+
+// @brief fixed-point transform
+template<bool is_fwd>
+int fix_transform(std::complex<short> *data, size_t N, const short *tw)
+{
+	// auxiliary
+	struct Aux {
+		typedef int (*FuncPtr)(short*, size_t, size_t,
+			const short*, const short*, int);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::SSSE3)
+				return &fix_stage_SSSE3<is_fwd>;
+
+			return &fix_stage_T<is_fwd>;
+		}
+	};
+
+	static typename Aux::FuncPtr run = Aux::select();
+
+	// bit-reversal reordering
+	for (size_t i = 0, L = 0; i < N-1; ++i)
+	{
+		if (i < L) std::swap(data[L], data[i]);
+
+		size_t R = N/2;
+		while (R <= L)
+		{
+			L -= R;
+			R /= 2;
+		}
+		L += R;
+	}
+
+	// initial maximum
+	short *x = reinterpret_cast<short*>(data);
+	int max_abs = 0;
+	for (size_t i = 0; i < 2*N; ++i)
+	{
+		const int v = x[i];
+		max_abs = std::max(max_abs, v < 0 ? -v : v);
+	}
+
+	// radix-2 stages
+	int exponent = 0;
+	for (size_t h = 1; h < N; h *= 2)
+	{
+		const int shift = fix_shift(max_abs);
+		max_abs = run(x, N, h, tw, tw + 2*h, shift);
+		exponent += shift;
+		tw += 4*h;
+	}
+
+	return exponent;
 }
 
+} // details namespace
+
 
 //////////////////////////////////////////////////////////////////////////
-// DFT assignment
-template<typename T>
-typename DFT<T>::this_type& DFT<T>::operator=(const this_type &x)
+// fixed-point DFT construction
+FixedDFT::FixedDFT(size_type DFT_size)
+	: m_size(DFT_size), m_log2(0)
 {
-	this_type t(x);
-	swap(t);
+	using namespace omni::util;
 
-	return *this;
+	assert(is_ipow2(DFT_size) && "invalid DFT size");
+	m_log2 = log2(DFT_size);
+
+	// stage twiddles: c = cos(pi*k/h), s = sin(pi*k/h), k < h
+	m_twiddle.reserve(4*m_size);
+	for (size_type h = 1; h < m_size; h *= 2)
+	{
+		const size_type first = m_twiddle.size();
+		m_twiddle.resize(first + 4*h);
+
+		short *cc = &m_twiddle[first];
+		short *ss = cc + 2*h;
+		for (size_type k = 0; k < h; ++k)
+		{
+			const double a = omni::util::PI * double(k) / double(h);
+			cc[2*k] = cc[2*k+1] = short(floor(32767*cos(a) + 0.5));
+			ss[2*k] = short(floor(32767*sin(a) + 0.5));
+			ss[2*k+1] = short(-ss[2*k]);
+		}
+	}
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-// swap two DFT
-template<typename T>
-void DFT<T>::swap(this_type &x)
+// fixed-point forward transform
+int FixedDFT::forward(value_type *data)
 {
-	std::swap(m_fwd_scale, x.m_fwd_scale);
-	std::swap(m_inv_scale, x.m_inv_scale);
+	return details::fix_transform<true>(data, m_size,
+		m_twiddle.empty() ? 0 : &m_twiddle[0]);
+}
 
-	std::swap(m_size, x.m_size);
-	std::swap(m_log2, x.m_log2);
-	std::swap(m_impl, x.m_impl);
+
+//////////////////////////////////////////////////////////////////////////
+// fixed-point inverse transform
+int FixedDFT::inverse(value_type *data)
+{
+	return details::fix_transform<false>(data, m_size,
+		m_twiddle.empty() ? 0 : &m_twiddle[0]);
 }
 
 
@@ -458,5 +2886,11 @@ void DFT<T>::swap(this_type &x)
 template class DFT<double>;
 template class DFT<float>;
 
+template class RDFT<double>;
+template class RDFT<float>;
+
+template class DFT2D<double>;
+template class DFT2D<float>;
+
 	} // dsp namespace
 } // omni namespace
@@ -21,22 +21,47 @@
 
 #include <complex>
 #include <vector>
+#include <string>
 
+#include <stddef.h>
 #include <assert.h>
 
+// matrix layout (see <omni/matrix.hpp>)
+#if !defined(OMNI_MATRIX_ROW_MAJOR)
+#	define OMNI_MATRIX_ROW_MAJOR 0
+#endif
+
 namespace omni
 {
+	namespace conf
+	{
+		template<typename Str>
+			class ItemT;
+	}
+
+	namespace mx
+	{
+		template<typename T, typename A>
+			class Matrix;
+	}
+
 	namespace dsp
 	{
 
 //////////////////////////////////////////////////////////////////////////
 // DFT class
+/*
+		The transform tables are shared by all objects of the same size,
+	but each object has its own scratch buffer, so one object shouldn't
+	be used by several threads at once (use a copy per thread).
+*/
 template<typename T>
 class DFT {
 	typedef DFT<T> this_type;
 
 public:
 	typedef std::complex<T> value_type;
+	typedef ptrdiff_t difference_type;
 	typedef size_t size_type;
 	typedef T scalar_type;
 
@@ -73,6 +98,32 @@ public:
 	}
 	void inverse(value_type *data);
 
+public:
+	// out-of-place forward transform
+	/*
+			The input x[0], x[x_stride], ..., x[(N-1)*x_stride] is
+		transformed to y[0], y[y_stride], ..., y[(N-1)*y_stride].
+		The input and output should not overlap.
+	*/
+	void forward(const value_type *x, difference_type x_stride,
+		value_type *y, difference_type y_stride);
+
+	// out-of-place inverse transform
+	void inverse(const value_type *x, difference_type x_stride,
+		value_type *y, difference_type y_stride);
+
+public:
+	// batched forward transform
+	/*
+			Transforms @a count vectors in place, the i-th vector
+		starts at data + i*distance. Large batches are split
+		across worker threads (multi-thread mode only).
+	*/
+	void forward_batch(value_type *data, size_type count, size_type distance);
+
+	// batched inverse transform
+	void inverse_batch(value_type *data, size_type count, size_type distance);
+
 public:
 	// DFT size
 	size_type size() const
@@ -103,6 +154,282 @@ private:
 	size_type m_size;
 	size_type m_log2;
 	void *m_impl;
+
+	std::vector<value_type> m_work; // transform scratch buffer
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// real DFT class
+/*
+		The forward transform converts N real numbers to the N/2+1
+	complex numbers (the other half of the spectrum is conjugate
+	symmetric). The inverse transform converts N/2+1 complex numbers
+	to N real numbers.
+
+		The even size transform is built on the N/2 complex DFT
+	with post-processing, so it's about twice faster than
+	the complex DFT of the promoted data.
+*/
+template<typename T>
+class RDFT {
+	typedef RDFT<T> this_type;
+
+public:
+	typedef std::complex<T> value_type;
+	typedef size_t size_type;
+	typedef T scalar_type;
+
+public:
+	explicit RDFT(size_type DFT_size);
+	RDFT(size_type DFT_size,
+		scalar_type fwd_scale,
+		scalar_type inv_scale);
+
+public:
+	// forward transform: N real => N/2+1 complex
+	template<typename A1, typename A2>
+	void forward(const std::vector<scalar_type, A1> &x,
+		std::vector<value_type, A2> &y)
+	{
+		assert(x.size()==size()
+			&& "invalid input data size");
+
+		y.resize(size()/2 + 1);
+		forward(&x[0], &y[0]);
+	}
+	void forward(const scalar_type *x, value_type *y);
+
+	// inverse transform: N/2+1 complex => N real
+	template<typename A1, typename A2>
+	void inverse(const std::vector<value_type, A1> &y,
+		std::vector<scalar_type, A2> &x)
+	{
+		assert(y.size()==size()/2 + 1
+			&& "invalid input data size");
+
+		x.resize(size());
+		inverse(&y[0], &x[0]);
+	}
+	void inverse(const value_type *y, scalar_type *x);
+
+public:
+	// DFT size
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	// forward transform scale
+	scalar_type forward_scale() const
+	{
+		return m_fwd_scale;
+	}
+
+	// inverse transform scale
+	scalar_type inverse_scale() const
+	{
+		return m_inv_scale;
+	}
+
+private:
+	void init();
+
+private:
+	scalar_type m_fwd_scale;
+	scalar_type m_inv_scale;
+
+	size_type m_size;
+	DFT<T> m_half; // N/2 (or N for odd sizes) complex DFT
+	std::vector<value_type> m_twiddle; // post-processing twiddles
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// 2-D DFT class
+/*
+		The transform of Nrows x Ncols matrix stored in omni::mx::Matrix
+	layout (column-major by default, see OMNI_MATRIX_ROW_MAJOR): the
+	contiguous vectors are transformed in batch, the strided vectors
+	are processed in blocks: the block is gathered to the contiguous
+	buffer (blocked transpose), transformed and scattered back.
+	Large matrices are processed by several threads.
+*/
+template<typename T>
+class DFT2D {
+	typedef DFT2D<T> this_type;
+
+public:
+	typedef std::complex<T> value_type;
+	typedef size_t size_type;
+	typedef T scalar_type;
+
+public:
+	DFT2D(size_type N_rows, size_type N_cols);
+	DFT2D(size_type N_rows, size_type N_cols,
+		scalar_type fwd_scale,
+		scalar_type inv_scale);
+
+public:
+	// forward transform
+	template<typename A>
+	void forward(mx::Matrix<value_type, A> &x)
+	{
+		assert(x.Nrows()==Nrows() && x.Ncols()==Ncols()
+			&& "invalid input matrix size");
+
+		forward(&x.at(0, 0));
+	}
+	void forward(value_type *data);
+
+	// inverse transform
+	template<typename A>
+	void inverse(mx::Matrix<value_type, A> &x)
+	{
+		assert(x.Nrows()==Nrows() && x.Ncols()==Ncols()
+			&& "invalid input matrix size");
+
+		inverse(&x.at(0, 0));
+	}
+	void inverse(value_type *data);
+
+public:
+	// number of rows
+	size_type Nrows() const
+	{
+	#if OMNI_MATRIX_ROW_MAJOR
+		return m_outer.size();
+	#else
+		return m_inner.size();
+	#endif
+	}
+
+	// number of columns
+	size_type Ncols() const
+	{
+	#if OMNI_MATRIX_ROW_MAJOR
+		return m_inner.size();
+	#else
+		return m_outer.size();
+	#endif
+	}
+
+private:
+	DFT<T> m_inner; // contiguous vectors (scaled)
+	DFT<T> m_outer; // strided vectors
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// fixed-point DFT class
+/*
+		The power of two transform of complex int16 (Q15) samples
+	with block floating point scaling. Before each radix-2 stage
+	the whole block is shifted right by 0, 1 or 2 bits, so the stage
+	never overflows. The total shift is returned as block exponent:
+
+		true_result = output * 2^exponent
+
+		Both transforms are not normalized, i.e. the inverse
+	transform of the forward transform is N*x.
+*/
+class FixedDFT {
+public:
+	typedef std::complex<short> value_type;
+	typedef size_t size_type;
+
+public:
+	explicit FixedDFT(size_type DFT_size);
+
+public:
+	// forward transform, returns block exponent
+	template<typename A>
+	int forward(std::vector<value_type, A> &data)
+	{
+		assert(data.size()==size()
+			&& "invalid input data size");
+
+		return forward(&data[0]);
+	}
+	int forward(value_type *data);
+
+	// inverse transform, returns block exponent
+	template<typename A>
+	int inverse(std::vector<value_type, A> &data)
+	{
+		assert(data.size()==size()
+			&& "invalid input data size");
+
+		return inverse(&data[0]);
+	}
+	int inverse(value_type *data);
+
+public:
+	// DFT size
+	size_type size() const
+	{
+		return m_size;
+	}
+
+private:
+	size_type m_size;
+	size_type m_log2;
+	std::vector<short> m_twiddle; // per stage: { c, c } and { s, -s } pairs
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// DFT planner
+/*
+		The transform algorithm is selected once per size, when the
+	first DFT of that size is created. In ESTIMATE mode (default)
+	the algorithm is selected by size only. In MEASURE mode all
+	suitable algorithms (radix-4, mixed-radix, Bluestein, direct,
+	four-step) are benchmarked and the fastest one is used.
+
+		The measured plans (wisdom) can be exported to the configuration
+	and imported back on the next run, so no re-measurement is needed.
+	The imported plans are used by the DFTs created after the import,
+	the existing DFTs keep their plans. The clear_wisdom() returns to
+	the estimated plans.
+
+	Example:
+		omni::Config wisdom;
+		DFT_Planner::set_mode(DFT_Planner::MEASURE);
+		DFT_Planner::plan<double>(1536);
+		DFT_Planner::export_wisdom(wisdom);
+*/
+class DFT_Planner {
+public:
+	enum Mode
+	{
+		ESTIMATE, // select by size
+		MEASURE   // benchmark on first use
+	};
+
+public:
+	// planner mode
+	static void set_mode(Mode mode);
+	static Mode mode();
+
+	// plan the size ahead of time
+	template<typename T>
+	static void plan(size_t N)
+	{
+		DFT<T> ft(N);
+	}
+
+public:
+	// save the measured plans
+	static void export_wisdom(conf::ItemT<std::string> &wisdom);
+	static void export_wisdom(conf::ItemT<std::wstring> &wisdom);
+
+	// load the measured plans
+	static void import_wisdom(const conf::ItemT<std::string> &wisdom);
+	static void import_wisdom(const conf::ItemT<std::wstring> &wisdom);
+
+	// forget all plans
+	static void clear_wisdom();
 };
 
 
@@ -122,6 +449,40 @@ void ifft(std::vector<std::complex<T>, A> &x)
 	ft.inverse(&x[0]);
 }
 
+// 2-D forward transform
+template<typename T, typename A> inline
+void fft2(mx::Matrix<std::complex<T>, A> &x)
+{
+	DFT2D<T> ft(x.Nrows(), x.Ncols());
+	ft.forward(x);
+}
+
+// 2-D inverse transform
+template<typename T, typename A> inline
+void ifft2(mx::Matrix<std::complex<T>, A> &x)
+{
+	DFT2D<T> ft(x.Nrows(), x.Ncols());
+	ft.inverse(x);
+}
+
+// real forward transform: N real => N/2+1 complex
+template<typename T, typename A1, typename A2> inline
+void rfft(const std::vector<T, A1> &x, std::vector<std::complex<T>, A2> &y)
+{
+	RDFT<T> ft(x.size());
+	ft.forward(x, y);
+}
+
+// real inverse transform: N/2+1 complex => N real, N is even
+template<typename T, typename A1, typename A2> inline
+void irfft(const std::vector<std::complex<T>, A1> &y, std::vector<T, A2> &x)
+{
+	assert(!y.empty() && "invalid input data size");
+
+	RDFT<T> ft(2*(y.size()-1));
+	ft.inverse(y, x);
+}
+
 template<typename T, typename A>
 void fft_shift(std::vector<T, A> &x)
 {
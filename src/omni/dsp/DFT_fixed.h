@@ -0,0 +1,37 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		http://omni.sourceforge.net
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Fixed-point DFT kernels (private, used by DFT.cpp and unit test)
+	@author Sergey Polichnoy
+*/
+#ifndef __OMNI_DFT_FIXED_H_
+#define __OMNI_DFT_FIXED_H_
+
+#include <stddef.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+		namespace details
+		{
+
+// fixed-point radix-2 stage: general or SSSE3 version (see FixedDFT)
+int fix_stage(short *x, size_t N, size_t h, const short *cc,
+	const short *ss, int shift, bool is_fwd, bool ssse3);
+
+		} // details namespace
+	} // dsp namespace
+} // omni namespace
+
+#endif // __OMNI_DFT_FIXED_H_
@@ -14,10 +14,787 @@
 	@brief Fast Hadamard Transorm.
 */
 #include <omni/dsp/FHT.hpp>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#include <algorithm>
+
+#if defined(__GNUC__)
+	// AVX code is compiled without global -mavx option
+#	define FHT_AVX_TARGET __attribute__((target("avx")))
+#	define FHT_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#	define FHT_AVX_TARGET
+#	define FHT_AVX2_TARGET
+#endif
 
 namespace omni
 {
 	namespace dsp
 	{
+		namespace details
+		{
+
+// cache block size (elements)
+const size_t FHT_BLOCK = 4096;
+
+// batch: number of interleaved arrays
+const size_t FHT_LANES = 8;
+
+// batch: maximum size of the interleaved arrays
+// (the larger arrays are faster with the radix-8 stage)
+const size_t FHT_INTERLEAVE_MAX = 4;
+
+
+// @brief transform kernels
+/*
+		inreg: strides 1, 2 and 4 of each 8 elements (radix-8),
+	the result is multiplied by the scale (floating-point only).
+		pass4: strides h and 2h (radix-4), h >= 8.
+		pass2: stride h (radix-2), h >= 8.
+*/
+template<typename T>
+struct FHT_Kernels {
+	void (*inreg)(T *x, size_t n, T scale);
+	void (*pass4)(T *x, size_t n, size_t h);
+	void (*pass2)(T *x, size_t n, size_t h);
+};
+
+
+// @brief kernels table
+template<typename T>
+FHT_Kernels<T> fht_kernels(void (*inreg)(T*, size_t, T),
+	void (*pass4)(T*, size_t, size_t), void (*pass2)(T*, size_t, size_t))
+{
+	FHT_Kernels<T> k;
+	k.inreg = inreg;
+	k.pass4 = pass4;
+	k.pass2 = pass2;
+	return k;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// common version
+
+// @brief radix-8 stage (common version)
+template<typename T>
+void fht_inreg_T(T *x, size_t n, T scale)
+{
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		// stride 1
+		const T a0 = x[0] + x[1], a1 = x[0] - x[1];
+		const T a2 = x[2] + x[3], a3 = x[2] - x[3];
+		const T a4 = x[4] + x[5], a5 = x[4] - x[5];
+		const T a6 = x[6] + x[7], a7 = x[6] - x[7];
+
+		// stride 2
+		const T b0 = a0 + a2, b2 = a0 - a2;
+		const T b1 = a1 + a3, b3 = a1 - a3;
+		const T b4 = a4 + a6, b6 = a4 - a6;
+		const T b5 = a5 + a7, b7 = a5 - a7;
+
+		// stride 4
+		x[0] = T((b0 + b4)*scale); x[4] = T((b0 - b4)*scale);
+		x[1] = T((b1 + b5)*scale); x[5] = T((b1 - b5)*scale);
+		x[2] = T((b2 + b6)*scale); x[6] = T((b2 - b6)*scale);
+		x[3] = T((b3 + b7)*scale); x[7] = T((b3 - b7)*scale);
+	}
+}
+
+
+// @brief radix-4 pass (common version)
+template<typename T>
+void fht_pass4_T(T *x, size_t n, size_t h)
+{
+	for (size_t i = 0; i < n; i += 4*h, x += 4*h)
+		for (size_t k = 0; k < h; ++k)
+	{
+		const T a = x[k] + x[k+h], b = x[k] - x[k+h];
+		const T c = x[k+2*h] + x[k+3*h], d = x[k+2*h] - x[k+3*h];
+
+		x[k]     = T(a + c);
+		x[k+h]   = T(b + d);
+		x[k+2*h] = T(a - c);
+		x[k+3*h] = T(b - d);
+	}
+}
+
+
+// @brief radix-2 pass (common version)
+template<typename T>
+void fht_pass2_T(T *x, size_t n, size_t h)
+{
+	for (size_t i = 0; i < n; i += 2*h, x += 2*h)
+		for (size_t k = 0; k < h; ++k)
+	{
+		const T a = x[k], b = x[k+h];
+		x[k]   = T(a + b);
+		x[k+h] = T(a - b);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// SSE2 version
+
+// float: four elements per register
+struct FHT_SSE2_F {
+	typedef float value_type;
+	typedef __m128 reg_type;
+	enum { W = 4 };
+
+	static reg_type load(const float *p) { return _mm_loadu_ps(p); }
+	static void store(float *p, reg_type a) { _mm_storeu_ps(p, a); }
+	static reg_type add(reg_type a, reg_type b) { return _mm_add_ps(a, b); }
+	static reg_type sub(reg_type a, reg_type b) { return _mm_sub_ps(a, b); }
+};
+
+// double: two elements per register
+struct FHT_SSE2_D {
+	typedef double value_type;
+	typedef __m128d reg_type;
+	enum { W = 2 };
+
+	static reg_type load(const double *p) { return _mm_loadu_pd(p); }
+	static void store(double *p, reg_type a) { _mm_storeu_pd(p, a); }
+	static reg_type add(reg_type a, reg_type b) { return _mm_add_pd(a, b); }
+	static reg_type sub(reg_type a, reg_type b) { return _mm_sub_pd(a, b); }
+};
+
+// short: eight elements per register
+struct FHT_SSE2_I16 {
+	typedef short value_type;
+	typedef __m128i reg_type;
+	enum { W = 8 };
+
+	static reg_type load(const short *p) { return _mm_loadu_si128((const __m128i*)p); }
+	static void store(short *p, reg_type a) { _mm_storeu_si128((__m128i*)p, a); }
+	static reg_type add(reg_type a, reg_type b) { return _mm_add_epi16(a, b); }
+	static reg_type sub(reg_type a, reg_type b) { return _mm_sub_epi16(a, b); }
+};
+
+// int: four elements per register
+struct FHT_SSE2_I32 {
+	typedef int value_type;
+	typedef __m128i reg_type;
+	enum { W = 4 };
+
+	static reg_type load(const int *p) { return _mm_loadu_si128((const __m128i*)p); }
+	static void store(int *p, reg_type a) { _mm_storeu_si128((__m128i*)p, a); }
+	static reg_type add(reg_type a, reg_type b) { return _mm_add_epi32(a, b); }
+	static reg_type sub(reg_type a, reg_type b) { return _mm_sub_epi32(a, b); }
+};
+
+
+// @brief radix-4 pass (SSE2 version)
+template<typename V>
+void fht_pass4_SSE2(typename V::value_type *x, size_t n, size_t h)
+{
+	typedef typename V::reg_type reg_type;
+
+	for (size_t i = 0; i < n; i += 4*h, x += 4*h)
+		for (size_t k = 0; k < h; k += V::W)
+	{
+		const reg_type x0 = V::load(x+k), x1 = V::load(x+k+h);
+		const reg_type x2 = V::load(x+k+2*h), x3 = V::load(x+k+3*h);
+
+		const reg_type a = V::add(x0, x1), b = V::sub(x0, x1);
+		const reg_type c = V::add(x2, x3), d = V::sub(x2, x3);
+
+		V::store(x+k,     V::add(a, c));
+		V::store(x+k+h,   V::add(b, d));
+		V::store(x+k+2*h, V::sub(a, c));
+		V::store(x+k+3*h, V::sub(b, d));
+	}
+}
+
+
+// @brief radix-2 pass (SSE2 version)
+template<typename V>
+void fht_pass2_SSE2(typename V::value_type *x, size_t n, size_t h)
+{
+	typedef typename V::reg_type reg_type;
+
+	for (size_t i = 0; i < n; i += 2*h, x += 2*h)
+		for (size_t k = 0; k < h; k += V::W)
+	{
+		const reg_type a = V::load(x+k), b = V::load(x+k+h);
+		V::store(x+k,   V::add(a, b));
+		V::store(x+k+h, V::sub(a, b));
+	}
+}
+
+
+// @brief radix-8 stage (SSE2 version, float)
+/*
+		Strides 1 and 2 are in-register: the swapped
+	register is added to the register with negated upper
+	elements of each pair.
+*/
+void fht_inreg_SSE2(float *x, size_t n, float scale)
+{
+	const __m128 neg1 = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+	const __m128 neg2 = _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f);
+	const __m128 s = _mm_set1_ps(scale);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m128 a = _mm_loadu_ps(x);
+		__m128 b = _mm_loadu_ps(x+4);
+
+		// stride 1
+		a = _mm_add_ps(_mm_xor_ps(a, neg1), _mm_shuffle_ps(a, a, _MM_SHUFFLE(2,3,0,1)));
+		b = _mm_add_ps(_mm_xor_ps(b, neg1), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2,3,0,1)));
+
+		// stride 2
+		a = _mm_add_ps(_mm_xor_ps(a, neg2), _mm_shuffle_ps(a, a, _MM_SHUFFLE(1,0,3,2)));
+		b = _mm_add_ps(_mm_xor_ps(b, neg2), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1,0,3,2)));
+
+		// stride 4
+		_mm_storeu_ps(x,   _mm_mul_ps(_mm_add_ps(a, b), s));
+		_mm_storeu_ps(x+4, _mm_mul_ps(_mm_sub_ps(a, b), s));
+	}
+}
+
+
+// @brief radix-8 stage (SSE2 version, double)
+void fht_inreg_SSE2(double *x, size_t n, double scale)
+{
+	const __m128d neg1 = _mm_setr_pd(0.0, -0.0);
+	const __m128d s = _mm_set1_pd(scale);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m128d a0 = _mm_loadu_pd(x), a1 = _mm_loadu_pd(x+2);
+		__m128d a2 = _mm_loadu_pd(x+4), a3 = _mm_loadu_pd(x+6);
+
+		// stride 1
+		a0 = _mm_add_pd(_mm_xor_pd(a0, neg1), _mm_shuffle_pd(a0, a0, 1));
+		a1 = _mm_add_pd(_mm_xor_pd(a1, neg1), _mm_shuffle_pd(a1, a1, 1));
+		a2 = _mm_add_pd(_mm_xor_pd(a2, neg1), _mm_shuffle_pd(a2, a2, 1));
+		a3 = _mm_add_pd(_mm_xor_pd(a3, neg1), _mm_shuffle_pd(a3, a3, 1));
+
+		// stride 2
+		const __m128d b0 = _mm_add_pd(a0, a1), b1 = _mm_sub_pd(a0, a1);
+		const __m128d b2 = _mm_add_pd(a2, a3), b3 = _mm_sub_pd(a2, a3);
+
+		// stride 4
+		_mm_storeu_pd(x,   _mm_mul_pd(_mm_add_pd(b0, b2), s));
+		_mm_storeu_pd(x+2, _mm_mul_pd(_mm_add_pd(b1, b3), s));
+		_mm_storeu_pd(x+4, _mm_mul_pd(_mm_sub_pd(b0, b2), s));
+		_mm_storeu_pd(x+6, _mm_mul_pd(_mm_sub_pd(b1, b3), s));
+	}
+}
+
+
+// @brief radix-8 stage (SSE2 version, short)
+/*
+		All three strides are in-register. The elements
+	are negated by the mask m: (a ^ m) - m.
+*/
+void fht_inreg_SSE2(short *x, size_t n, short)
+{
+	const __m128i m1 = _mm_setr_epi16(0, -1, 0, -1, 0, -1, 0, -1);
+	const __m128i m2 = _mm_setr_epi16(0, 0, -1, -1, 0, 0, -1, -1);
+	const __m128i m4 = _mm_setr_epi16(0, 0, 0, 0, -1, -1, -1, -1);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)x);
+
+		// stride 1
+		a = _mm_add_epi16(_mm_sub_epi16(_mm_xor_si128(a, m1), m1),
+			_mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1)));
+
+		// stride 2
+		a = _mm_add_epi16(_mm_sub_epi16(_mm_xor_si128(a, m2), m2),
+			_mm_shuffle_epi32(a, _MM_SHUFFLE(2,3,0,1)));
+
+		// stride 4
+		a = _mm_add_epi16(_mm_sub_epi16(_mm_xor_si128(a, m4), m4),
+			_mm_shuffle_epi32(a, _MM_SHUFFLE(1,0,3,2)));
+
+		_mm_storeu_si128((__m128i*)x, a);
+	}
+}
+
+
+// @brief radix-8 stage (SSE2 version, int)
+void fht_inreg_SSE2(int *x, size_t n, int)
+{
+	const __m128i m1 = _mm_setr_epi32(0, -1, 0, -1);
+	const __m128i m2 = _mm_setr_epi32(0, 0, -1, -1);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)x);
+		__m128i b = _mm_loadu_si128((const __m128i*)(x+4));
+
+		// stride 1
+		a = _mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(a, m1), m1), _mm_shuffle_epi32(a, _MM_SHUFFLE(2,3,0,1)));
+		b = _mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(b, m1), m1), _mm_shuffle_epi32(b, _MM_SHUFFLE(2,3,0,1)));
+
+		// stride 2
+		a = _mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(a, m2), m2), _mm_shuffle_epi32(a, _MM_SHUFFLE(1,0,3,2)));
+		b = _mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(b, m2), m2), _mm_shuffle_epi32(b, _MM_SHUFFLE(1,0,3,2)));
+
+		// stride 4
+		_mm_storeu_si128((__m128i*)x,     _mm_add_epi32(a, b));
+		_mm_storeu_si128((__m128i*)(x+4), _mm_sub_epi32(a, b));
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// AVX version
+
+// float: eight elements per register
+struct FHT_AVX_F {
+	typedef float value_type;
+	typedef __m256 reg_type;
+	enum { W = 8 };
+
+	static FHT_AVX_TARGET reg_type load(const float *p) { return _mm256_loadu_ps(p); }
+	static FHT_AVX_TARGET void store(float *p, reg_type a) { _mm256_storeu_ps(p, a); }
+	static FHT_AVX_TARGET reg_type add(reg_type a, reg_type b) { return _mm256_add_ps(a, b); }
+	static FHT_AVX_TARGET reg_type sub(reg_type a, reg_type b) { return _mm256_sub_ps(a, b); }
+};
+
+// double: four elements per register
+struct FHT_AVX_D {
+	typedef double value_type;
+	typedef __m256d reg_type;
+	enum { W = 4 };
+
+	static FHT_AVX_TARGET reg_type load(const double *p) { return _mm256_loadu_pd(p); }
+	static FHT_AVX_TARGET void store(double *p, reg_type a) { _mm256_storeu_pd(p, a); }
+	static FHT_AVX_TARGET reg_type add(reg_type a, reg_type b) { return _mm256_add_pd(a, b); }
+	static FHT_AVX_TARGET reg_type sub(reg_type a, reg_type b) { return _mm256_sub_pd(a, b); }
+};
+
+
+// @brief radix-4 pass (AVX version)
+template<typename V> FHT_AVX_TARGET
+void fht_pass4_AVX(typename V::value_type *x, size_t n, size_t h)
+{
+	typedef typename V::reg_type reg_type;
+
+	for (size_t i = 0; i < n; i += 4*h, x += 4*h)
+		for (size_t k = 0; k < h; k += V::W)
+	{
+		const reg_type x0 = V::load(x+k), x1 = V::load(x+k+h);
+		const reg_type x2 = V::load(x+k+2*h), x3 = V::load(x+k+3*h);
+
+		const reg_type a = V::add(x0, x1), b = V::sub(x0, x1);
+		const reg_type c = V::add(x2, x3), d = V::sub(x2, x3);
+
+		V::store(x+k,     V::add(a, c));
+		V::store(x+k+h,   V::add(b, d));
+		V::store(x+k+2*h, V::sub(a, c));
+		V::store(x+k+3*h, V::sub(b, d));
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-2 pass (AVX version)
+template<typename V> FHT_AVX_TARGET
+void fht_pass2_AVX(typename V::value_type *x, size_t n, size_t h)
+{
+	typedef typename V::reg_type reg_type;
+
+	for (size_t i = 0; i < n; i += 2*h, x += 2*h)
+		for (size_t k = 0; k < h; k += V::W)
+	{
+		const reg_type a = V::load(x+k), b = V::load(x+k+h);
+		V::store(x+k,   V::add(a, b));
+		V::store(x+k+h, V::sub(a, b));
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-8 stage (AVX version, float)
+FHT_AVX_TARGET
+void fht_inreg_AVX(float *x, size_t n, float scale)
+{
+	const __m256 neg1 = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+	const __m256 neg2 = _mm256_setr_ps(0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f, -0.0f);
+	const __m256 neg4 = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, -0.0f, -0.0f, -0.0f, -0.0f);
+	const __m256 s = _mm256_set1_ps(scale);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m256 a = _mm256_loadu_ps(x);
+
+		a = _mm256_add_ps(_mm256_xor_ps(a, neg1), _mm256_permute_ps(a, _MM_SHUFFLE(2,3,0,1)));
+		a = _mm256_add_ps(_mm256_xor_ps(a, neg2), _mm256_permute_ps(a, _MM_SHUFFLE(1,0,3,2)));
+		a = _mm256_add_ps(_mm256_xor_ps(a, neg4), _mm256_permute2f128_ps(a, a, 1));
+
+		_mm256_storeu_ps(x, _mm256_mul_ps(a, s));
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-8 stage (AVX version, double)
+FHT_AVX_TARGET
+void fht_inreg_AVX(double *x, size_t n, double scale)
+{
+	const __m256d neg1 = _mm256_setr_pd(0.0, -0.0, 0.0, -0.0);
+	const __m256d neg2 = _mm256_setr_pd(0.0, 0.0, -0.0, -0.0);
+	const __m256d s = _mm256_set1_pd(scale);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m256d a = _mm256_loadu_pd(x);
+		__m256d b = _mm256_loadu_pd(x+4);
+
+		// stride 1
+		a = _mm256_add_pd(_mm256_xor_pd(a, neg1), _mm256_permute_pd(a, 0x5));
+		b = _mm256_add_pd(_mm256_xor_pd(b, neg1), _mm256_permute_pd(b, 0x5));
+
+		// stride 2
+		a = _mm256_add_pd(_mm256_xor_pd(a, neg2), _mm256_permute2f128_pd(a, a, 1));
+		b = _mm256_add_pd(_mm256_xor_pd(b, neg2), _mm256_permute2f128_pd(b, b, 1));
+
+		// stride 4
+		_mm256_storeu_pd(x,   _mm256_mul_pd(_mm256_add_pd(a, b), s));
+		_mm256_storeu_pd(x+4, _mm256_mul_pd(_mm256_sub_pd(a, b), s));
+	}
+
+	_mm256_zeroupper();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// AVX2 version (int)
+
+// @brief radix-8 stage (AVX2 version, int)
+FHT_AVX2_TARGET
+void fht_inreg_AVX2(int *x, size_t n, int)
+{
+	const __m256i m1 = _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+	const __m256i m2 = _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+	const __m256i m4 = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+
+	for (size_t i = 0; i < n; i += 8, x += 8)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i*)x);
+
+		a = _mm256_add_epi32(_mm256_sub_epi32(_mm256_xor_si256(a, m1), m1),
+			_mm256_shuffle_epi32(a, _MM_SHUFFLE(2,3,0,1)));
+		a = _mm256_add_epi32(_mm256_sub_epi32(_mm256_xor_si256(a, m2), m2),
+			_mm256_shuffle_epi32(a, _MM_SHUFFLE(1,0,3,2)));
+		a = _mm256_add_epi32(_mm256_sub_epi32(_mm256_xor_si256(a, m4), m4),
+			_mm256_permute2x128_si256(a, a, 1));
+
+		_mm256_storeu_si256((__m256i*)x, a);
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-4 pass (AVX2 version, int)
+FHT_AVX2_TARGET
+void fht_pass4_AVX2(int *x, size_t n, size_t h)
+{
+	for (size_t i = 0; i < n; i += 4*h, x += 4*h)
+		for (size_t k = 0; k < h; k += 8)
+	{
+		const __m256i x0 = _mm256_loadu_si256((const __m256i*)(x+k));
+		const __m256i x1 = _mm256_loadu_si256((const __m256i*)(x+k+h));
+		const __m256i x2 = _mm256_loadu_si256((const __m256i*)(x+k+2*h));
+		const __m256i x3 = _mm256_loadu_si256((const __m256i*)(x+k+3*h));
+
+		const __m256i a = _mm256_add_epi32(x0, x1), b = _mm256_sub_epi32(x0, x1);
+		const __m256i c = _mm256_add_epi32(x2, x3), d = _mm256_sub_epi32(x2, x3);
+
+		_mm256_storeu_si256((__m256i*)(x+k),     _mm256_add_epi32(a, c));
+		_mm256_storeu_si256((__m256i*)(x+k+h),   _mm256_add_epi32(b, d));
+		_mm256_storeu_si256((__m256i*)(x+k+2*h), _mm256_sub_epi32(a, c));
+		_mm256_storeu_si256((__m256i*)(x+k+3*h), _mm256_sub_epi32(b, d));
+	}
+
+	_mm256_zeroupper();
+}
+
+
+// @brief radix-2 pass (AVX2 version, int)
+FHT_AVX2_TARGET
+void fht_pass2_AVX2(int *x, size_t n, size_t h)
+{
+	for (size_t i = 0; i < n; i += 2*h, x += 2*h)
+		for (size_t k = 0; k < h; k += 8)
+	{
+		const __m256i a = _mm256_loadu_si256((const __m256i*)(x+k));
+		const __m256i b = _mm256_loadu_si256((const __m256i*)(x+k+h));
+		_mm256_storeu_si256((__m256i*)(x+k),   _mm256_add_epi32(a, b));
+		_mm256_storeu_si256((__m256i*)(x+k+h), _mm256_sub_epi32(a, b));
+	}
+
+	_mm256_zeroupper();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// kernels selection
+
+// float
+const FHT_Kernels<float>& fht_kernels(float*)
+{
+	// auxiliary
+	struct Aux {
+		static FHT_Kernels<float> select()
+		{
+			if (SIMD::Capability::AVX)
+				return fht_kernels<float>(&fht_inreg_AVX,
+					&fht_pass4_AVX<FHT_AVX_F>, &fht_pass2_AVX<FHT_AVX_F>);
+			if (SIMD::Capability::SSE2)
+				return fht_kernels<float>(&fht_inreg_SSE2,
+					&fht_pass4_SSE2<FHT_SSE2_F>, &fht_pass2_SSE2<FHT_SSE2_F>);
+
+			return fht_kernels<float>(&fht_inreg_T<float>,
+				&fht_pass4_T<float>, &fht_pass2_T<float>);
+		}
+	};
+
+	static const FHT_Kernels<float> run = Aux::select();
+	return run;
+}
+
+// double
+const FHT_Kernels<double>& fht_kernels(double*)
+{
+	// auxiliary
+	struct Aux {
+		static FHT_Kernels<double> select()
+		{
+			if (SIMD::Capability::AVX)
+				return fht_kernels<double>(&fht_inreg_AVX,
+					&fht_pass4_AVX<FHT_AVX_D>, &fht_pass2_AVX<FHT_AVX_D>);
+			if (SIMD::Capability::SSE2)
+				return fht_kernels<double>(&fht_inreg_SSE2,
+					&fht_pass4_SSE2<FHT_SSE2_D>, &fht_pass2_SSE2<FHT_SSE2_D>);
+
+			return fht_kernels<double>(&fht_inreg_T<double>,
+				&fht_pass4_T<double>, &fht_pass2_T<double>);
+		}
+	};
+
+	static const FHT_Kernels<double> run = Aux::select();
+	return run;
+}
+
+// short
+/*
+		The radix-8 stage fills the whole SSE2 register,
+	so there is no AVX2 version (the strides are >= 8).
+*/
+const FHT_Kernels<short>& fht_kernels(short*)
+{
+	// auxiliary
+	struct Aux {
+		static FHT_Kernels<short> select()
+		{
+			if (SIMD::Capability::SSE2)
+				return fht_kernels<short>(&fht_inreg_SSE2,
+					&fht_pass4_SSE2<FHT_SSE2_I16>, &fht_pass2_SSE2<FHT_SSE2_I16>);
+
+			return fht_kernels<short>(&fht_inreg_T<short>,
+				&fht_pass4_T<short>, &fht_pass2_T<short>);
+		}
+	};
+
+	static const FHT_Kernels<short> run = Aux::select();
+	return run;
+}
+
+// int
+const FHT_Kernels<int>& fht_kernels(int*)
+{
+	// auxiliary
+	struct Aux {
+		static FHT_Kernels<int> select()
+		{
+			if (SIMD::Capability::AVX2)
+				return fht_kernels<int>(&fht_inreg_AVX2,
+					&fht_pass4_AVX2, &fht_pass2_AVX2);
+			if (SIMD::Capability::SSE2)
+				return fht_kernels<int>(&fht_inreg_SSE2,
+					&fht_pass4_SSE2<FHT_SSE2_I32>, &fht_pass2_SSE2<FHT_SSE2_I32>);
+
+			return fht_kernels<int>(&fht_inreg_T<int>,
+				&fht_pass4_T<int>, &fht_pass2_T<int>);
+		}
+	};
+
+	static const FHT_Kernels<int> run = Aux::select();
+	return run;
+}
+
+
+// @brief strides [h, h_end) of n elements
+template<typename T>
+void fht_passes(const FHT_Kernels<T> &k, T *x, size_t n, size_t h, size_t h_end)
+{
+	for (; 4*h <= h_end; h *= 4)
+		k.pass4(x, n, h);
+	if (h < h_end)
+		k.pass2(x, n, h);
+}
+
+
+// @brief cache blocked transform
+/*
+		The radix-8 stage and the strides less than FHT_BLOCK
+	are done block by block, then the large strides are done
+	over the whole array.
+*/
+template<typename T>
+void fht_run(T *x, size_t N, T scale)
+{
+	if (N < 8)
+	{
+		ifht_T(x, N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = T(x[i]*scale);
+		return;
+	}
+
+	const FHT_Kernels<T> &k = fht_kernels((T*)0);
+	const size_t B = std::min(N, FHT_BLOCK);
+
+	for (size_t i = 0; i < N; i += B)
+	{
+		k.inreg(x + i, B, scale);
+		fht_passes(k, x + i, B, 8, B);
+	}
+
+	fht_passes(k, x, N, B, N);
+}
+
+
+// @brief batched transform
+/*
+		The small arrays are interleaved by FHT_LANES: the element n
+	of the array j is at tmp[n*FHT_LANES + j]. So the strides 1..N/2
+	become the strides FHT_LANES..FHT_LANES*N/2 of the radix-4 and
+	radix-2 passes and each register holds the same element of several
+	arrays. The rest arrays are transformed one by one.
+*/
+template<typename T>
+void fht_batch_run(T *x, size_t N, size_t count, size_t distance, T scale)
+{
+	size_t i = 0;
+
+	if (N <= FHT_INTERLEAVE_MAX)
+	{
+		const FHT_Kernels<T> &k = fht_kernels((T*)0);
+		const size_t L = FHT_LANES;
+		T tmp[FHT_LANES*FHT_INTERLEAVE_MAX];
+
+		for (; i+L <= count; i += L)
+		{
+			T *xi = x + i*distance;
+
+			for (size_t j = 0; j < L; ++j)
+				for (size_t n = 0; n < N; ++n)
+					tmp[n*L + j] = xi[j*distance + n];
+
+			fht_passes(k, tmp, L*N, L, L*N);
+
+			for (size_t j = 0; j < L; ++j)
+				for (size_t n = 0; n < N; ++n)
+					xi[j*distance + n] = T(tmp[n*L + j]*scale);
+		}
+	}
+
+	for (; i < count; ++i)
+		fht_run(x + i*distance, N, scale);
+}
+
+		} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// Inverse Hadamard Transform
+void ifht(float *x, size_t N)
+{
+	details::fht_run(x, N, 1.0f);
+}
+
+void ifht(double *x, size_t N)
+{
+	details::fht_run(x, N, 1.0);
+}
+
+void ifht(short *x, size_t N)
+{
+	details::fht_run(x, N, short(1));
+}
+
+void ifht(int *x, size_t N)
+{
+	details::fht_run(x, N, 1);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Hadamard Transform
+void fht(float *x, size_t N)
+{
+	details::fht_run(x, N, float(1.0/N));
+}
+
+void fht(double *x, size_t N)
+{
+	details::fht_run(x, N, 1.0/N);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// batched Inverse Hadamard Transform
+void ifht_batch(float *x, size_t N, size_t count, size_t distance)
+{
+	details::fht_batch_run(x, N, count, distance, 1.0f);
+}
+
+void ifht_batch(double *x, size_t N, size_t count, size_t distance)
+{
+	details::fht_batch_run(x, N, count, distance, 1.0);
+}
+
+void ifht_batch(short *x, size_t N, size_t count, size_t distance)
+{
+	details::fht_batch_run(x, N, count, distance, short(1));
+}
+
+void ifht_batch(int *x, size_t N, size_t count, size_t distance)
+{
+	details::fht_batch_run(x, N, count, distance, 1);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// batched Hadamard Transform
+void fht_batch(float *x, size_t N, size_t count, size_t distance)
+{
+	details::fht_batch_run(x, N, count, distance, float(1.0/N));
+}
+
+void fht_batch(double *x, size_t N, size_t count, size_t distance)
+{
+	details::fht_batch_run(x, N, count, distance, 1.0/N);
+}
+
 	} // dsp namespace
 } // omni namespace
@@ -26,19 +26,20 @@ namespace omni
 	namespace dsp
 	{
 
+		namespace details
+		{
+
 //////////////////////////////////////////////////////////////////////////
-/// @brief Inverse Hadamard Transform.
+/// @brief Inverse Hadamard Transform (common version).
 /**
-		This function performs the Inverse Fast Hadamard Transform of the vector @a x.
-
-	The vector size should be integer power of two.
+		The in-place butterflies (a, b) => (a+b, a-b), stage by stage.
 
 @param[in,out] x The vector.
+@param[in] N The vector size, integer power of two.
 */
-template<typename T, typename A>
-void ifht(std::vector<T,A> &x)
+template<typename T>
+void ifht_T(T *x, size_t N)
 {
-	const size_t N = x.size();
 	const size_t N_log2 = util::log2(N);
 
 	size_t P = N/2;
@@ -56,6 +57,124 @@ void ifht(std::vector<T,A> &x)
 	}
 }
 
+		} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Inverse Hadamard Transform of the array.
+/**
+		This function performs the Inverse Fast Hadamard Transform
+	of the array @a x of size @a N.
+
+		The float, double, short and int arrays are processed by
+	the cache blocked SIMD version: the radix-8 in-register stage
+	is followed by radix-4 passes over the cache sized blocks.
+	The short and int arithmetic is modular: the input range
+	should leave log2(N) bits for the sums.
+
+@param[in,out] x The array.
+@param[in] N The array size, integer power of two.
+*/
+template<typename T> inline
+void ifht(T *x, size_t N)
+{
+	details::ifht_T(x, N);
+}
+
+// cache blocked SIMD versions
+void ifht(float *x, size_t N);
+void ifht(double *x, size_t N);
+void ifht(short *x, size_t N);
+void ifht(int *x, size_t N);
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Hadamard Transform of the array.
+/**
+		This function performs the Fast Hadamard Transform
+	of the array @a x of size @a N (the inverse transform scaled by 1/N).
+
+@param[in,out] x The array.
+@param[in] N The array size, integer power of two.
+*/
+template<typename T> inline
+void fht(T *x, size_t N)
+{
+	ifht(x, N);
+
+	// normalization
+	const T nrm = T(1.0 / N);
+	for (size_t i = 0; i < N; ++i)
+		x[i] *= nrm;
+}
+
+// cache blocked SIMD versions (normalization in the first stage)
+void fht(float *x, size_t N);
+void fht(double *x, size_t N);
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Batched Inverse Hadamard Transform.
+/**
+		This function transforms @a count arrays of size @a N,
+	the i-th array starts at x + i*distance (the bank of Walsh
+	correlators).
+
+@param[in,out] x The first array.
+@param[in] N The array size, integer power of two.
+@param[in] count The number of arrays.
+@param[in] distance The distance between arrays.
+*/
+template<typename T> inline
+void ifht_batch(T *x, size_t N, size_t count, size_t distance)
+{
+	for (size_t i = 0; i < count; ++i)
+		ifht(x + i*distance, N);
+}
+
+// cache blocked SIMD versions
+void ifht_batch(float *x, size_t N, size_t count, size_t distance);
+void ifht_batch(double *x, size_t N, size_t count, size_t distance);
+void ifht_batch(short *x, size_t N, size_t count, size_t distance);
+void ifht_batch(int *x, size_t N, size_t count, size_t distance);
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Batched Hadamard Transform.
+/**
+@param[in,out] x The first array.
+@param[in] N The array size, integer power of two.
+@param[in] count The number of arrays.
+@param[in] distance The distance between arrays.
+*/
+template<typename T> inline
+void fht_batch(T *x, size_t N, size_t count, size_t distance)
+{
+	for (size_t i = 0; i < count; ++i)
+		fht(x + i*distance, N);
+}
+
+// cache blocked SIMD versions
+void fht_batch(float *x, size_t N, size_t count, size_t distance);
+void fht_batch(double *x, size_t N, size_t count, size_t distance);
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Inverse Hadamard Transform.
+/**
+		This function performs the Inverse Fast Hadamard Transform of the vector @a x.
+
+	The vector size should be integer power of two.
+
+@param[in,out] x The vector.
+*/
+template<typename T, typename A>
+void ifht(std::vector<T,A> &x)
+{
+	if (!x.empty())
+		ifht(&x[0], x.size());
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 /// @brief Hadamard Transform.
@@ -69,13 +188,8 @@ void ifht(std::vector<T,A> &x)
 template<typename T, typename A>
 void fht(std::vector<T,A> &x)
 {
-	ifht(x);
-
-	// normalization
-	const size_t N = x.size();
-	const T nrm = T(1.0 / N);
-	for (size_t i = 0; i < N; ++i)
-		x[i] *= nrm;
+	if (!x.empty())
+		fht(&x[0], x.size());
 }
 
 	} // dsp namespace
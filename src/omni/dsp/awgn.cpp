@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Implementation of the AWGN channel.
+
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/awgn.h>
+
+#include <omni/rand.hpp>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+#include <math.h>
+
+// noise kernels
+namespace
+{
+
+// noise block size (real numbers)
+enum { NOISE_BLOCK = 512 };
+
+
+//////////////////////////////////////////////////////////////////////////
+// x[i] += n[i] (general version)
+template<typename T>
+void add_noise_T(size_t N, T *x, const double *n)
+{
+	for (size_t i = 0; i < N; ++i)
+		x[i] += T(n[i]);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// x[i] += n[i] (SSE2 version, no alignment required)
+void add_noise_SSE2(size_t N, double *x, const double *n)
+{
+	for (; 4 <= N; N -= 4)
+	{
+		__m128d x0 = _mm_loadu_pd(x+0);
+		__m128d x1 = _mm_loadu_pd(x+2);
+		x0 = _mm_add_pd(x0, _mm_loadu_pd(n+0));
+		x1 = _mm_add_pd(x1, _mm_loadu_pd(n+2));
+		_mm_storeu_pd(x+0, x0);
+		_mm_storeu_pd(x+2, x1);
+
+		x += 4;
+		n += 4;
+	}
+
+	add_noise_T(N, x, n);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// x[i] += n[i] (SSE2 version, no alignment required)
+void add_noise_SSE2(size_t N, float *x, const double *n)
+{
+	for (; 4 <= N; N -= 4)
+	{
+		const __m128 n01 = _mm_cvtpd_ps(_mm_loadu_pd(n+0));
+		const __m128 n23 = _mm_cvtpd_ps(_mm_loadu_pd(n+2));
+
+		__m128 x0 = _mm_loadu_ps(x);
+		x0 = _mm_add_ps(x0, _mm_movelh_ps(n01, n23));
+		_mm_storeu_ps(x, x0);
+
+		x += 4;
+		n += 4;
+	}
+
+	add_noise_T(N, x, n);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// add noise to the buffer of real numbers
+template<typename T>
+void add_noise(size_t N, T *x, double stdev)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(size_t, T*, const double*);
+
+		static FuncPtr select()
+		{
+			if (omni::SIMD::Capability::SSE2)
+				return &add_noise_SSE2;
+
+			return &add_noise_T<T>;
+		}
+	};
+
+	static typename Aux::FuncPtr run = Aux::select();
+
+	double noise[NOISE_BLOCK];
+	while (N)
+	{
+		const size_t n = (N < size_t(NOISE_BLOCK)) ? N : size_t(NOISE_BLOCK);
+		omni::rnd::rnorm(noise, n, stdev);
+		run(n, x, noise);
+
+		x += n;
+		N -= n;
+	}
+}
+
+} // noise kernels
+
+
+namespace omni
+{
+	namespace dsp
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Add the White Gaussian Noise.
+/**
+		This function adds the complex White Gaussian Noise
+	to the buffer [@a x, @a x + @a N) in place.
+
+		The standard deviation @a stdev is specified for whole
+	complex sample (the same as for rnd::wgn()).
+
+@param x Begin of the buffer.
+@param N The buffer size.
+@param stdev The standard deviation.
+*/
+void add_wgn(std::complex<double> *x, size_t N, double stdev)
+{
+	add_noise(2*N, reinterpret_cast<double*>(x), stdev/sqrt(2.0));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Add the White Gaussian Noise.
+/**
+		This function adds the complex White Gaussian Noise
+	to the buffer [@a x, @a x + @a N) in place.
+
+		The standard deviation @a stdev is specified for whole
+	complex sample (the same as for rnd::wgn()).
+
+@param x Begin of the buffer.
+@param N The buffer size.
+@param stdev The standard deviation.
+*/
+void add_wgn(std::complex<float> *x, size_t N, double stdev)
+{
+	add_noise(2*N, reinterpret_cast<float*>(x), stdev/sqrt(2.0));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The AWGN channel.
+/**
+		This function adds the complex White Gaussian Noise
+	to the buffer [@a x, @a x + @a N) in place. The noise
+	power is calculated by the Es/N0 ratio:
+
+@code
+	N0 = Es / pow(10, EsN0_dB/10)
+@endcode
+
+@param x Begin of the buffer.
+@param N The buffer size.
+@param EsN0_dB The Es/N0 ratio in decibels.
+@param Es The average symbol energy.
+*/
+void awgn(std::complex<double> *x, size_t N, double EsN0_dB, double Es)
+{
+	const double N0 = Es / pow(10.0, EsN0_dB/10.0);
+	add_wgn(x, N, sqrt(N0));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The AWGN channel.
+/**
+		This function adds the complex White Gaussian Noise
+	to the buffer [@a x, @a x + @a N) in place. The noise
+	power is calculated by the Es/N0 ratio:
+
+@code
+	N0 = Es / pow(10, EsN0_dB/10)
+@endcode
+
+@param x Begin of the buffer.
+@param N The buffer size.
+@param EsN0_dB The Es/N0 ratio in decibels.
+@param Es The average symbol energy.
+*/
+void awgn(std::complex<float> *x, size_t N, double EsN0_dB, double Es)
+{
+	const double N0 = Es / pow(10.0, EsN0_dB/10.0);
+	add_wgn(x, N, sqrt(N0));
+}
+
+	} // dsp namespace
+} // omni namespace
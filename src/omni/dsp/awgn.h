@@ -0,0 +1,44 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Interface of the AWGN channel.
+
+		The AWGN functions add the complex White Gaussian Noise
+	to the whole buffer in place. The noise is taken from the
+	per-thread global normal generator (see rnd::rnorm()) block
+	by block, and the SSE2 instructions are used if supported.
+
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#ifndef __OMNI_AWGN_H_
+#define __OMNI_AWGN_H_
+
+#include <omni/defs.hpp>
+
+#include <complex>
+
+namespace omni
+{
+	namespace dsp
+	{
+
+void add_wgn(std::complex<double> *x, size_t N, double stdev);
+void add_wgn(std::complex<float> *x, size_t N, double stdev);
+
+void awgn(std::complex<double> *x, size_t N, double EsN0_dB, double Es = 1.0);
+void awgn(std::complex<float> *x, size_t N, double EsN0_dB, double Es = 1.0);
+
+	} // dsp namespace
+} // omni namespace
+
+#endif // __OMNI_AWGN_H_
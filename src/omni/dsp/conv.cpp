@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Fast convolution and correlation
+	@author Sergey Polichnoy
+*/
+#include <omni/dsp/conv.h>
+
+#include <algorithm>
+
+namespace omni
+{
+	namespace dsp
+	{
+		namespace details
+		{
+
+// maximum FFT block size
+const size_t CONV_FFT_MAX = 1<<20;
+
+
+// @brief number of operations: direct filtering
+/*
+		One complex multiply-add (8 operations) per coefficient
+	for each output sample.
+*/
+inline double conv_direct_cost(size_t N_coef, size_t n)
+{
+	return 8.0 * N_coef * n;
+}
+
+
+// @brief number of operations: overlap-save block
+/*
+		Two FFTs (5*N*log2(N) operations each) and the
+	spectrum product (6*N operations).
+*/
+inline double conv_fft_cost(size_t N)
+{
+	size_t N_log2 = 0;
+	while ((size_t(1)<<N_log2) < N)
+		++N_log2;
+
+	return 10.0*N*N_log2 + 6.0*N;
+}
+
+		} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// FFT block size
+/*
+		The power of two which gives the minimum
+	cost per output sample: cost(N) / (N - M + 1).
+*/
+template<typename T>
+typename Convolver<T>::size_type Convolver<T>::fft_size(size_type N_coef)
+{
+	size_type best_N = 1;
+	while (best_N < 2*N_coef)
+		best_N *= 2;
+	double best_cost = details::conv_fft_cost(best_N) / (best_N - N_coef + 1);
+
+	for (size_type N = 2*best_N; N <= details::CONV_FFT_MAX; N *= 2)
+	{
+		const double cost = details::conv_fft_cost(N) / (N - N_coef + 1);
+		if (best_cost <= cost)
+			break;
+
+		best_cost = cost;
+		best_N = N;
+	}
+
+	return best_N;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// initialization
+template<typename T>
+void Convolver<T>::init(Mode mode)
+{
+	assert(!m_coef.empty() && "no coefficients");
+	const size_type M = m_coef.size();
+	const size_type N = m_dft.size();
+
+	// correlation: reversed conjugated pattern
+	if (CORRELATION == mode)
+	{
+		std::reverse(m_coef.begin(), m_coef.end());
+		for (size_type i = 0; i < M; ++i)
+			m_coef[i] = std::conj(m_coef[i]);
+	}
+
+	// spectrum (with the inverse transform scale)
+	m_spectrum.assign(N, value_type());
+	for (size_type i = 0; i < M; ++i)
+		m_spectrum[i] = m_coef[i] / scalar_type(N);
+	m_dft.forward(m_spectrum);
+
+	m_frame.assign(N, value_type());
+	m_work.resize(N);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// clear the filter state
+template<typename T>
+void Convolver<T>::reset()
+{
+	std::fill(m_frame.begin(),
+		m_frame.end(), value_type());
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// use FFT for n-samples block?
+template<typename T>
+bool Convolver<T>::is_fft(size_type n) const
+{
+	const size_type M = m_coef.size();
+	const size_type L = m_dft.size() - M + 1;
+
+	// FFT blocks: n/L full, and the partial one
+	const double fft_cost = details::conv_fft_cost(m_dft.size()) * ((n + L-1) / L);
+	return fft_cost < details::conv_direct_cost(M, n);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// filter the block
+template<typename T>
+void Convolver<T>::process(const value_type *x, value_type *y, size_type n)
+{
+	const size_type M = m_coef.size();
+	const size_type L = m_dft.size() - M + 1;
+
+	// m_frame[0..M-1) is the previous input
+	while (0 < n)
+	{
+		const size_type k = std::min(n, L);
+		std::copy(x, x+k, m_frame.begin() + (M-1));
+
+		if (is_fft(k))
+			do_fft(y, k);
+		else
+			do_direct(y, k);
+
+		// save the history
+		std::copy(m_frame.begin() + k,
+			m_frame.begin() + (k+M-1),
+			m_frame.begin());
+
+		x += k;
+		y += k;
+		n -= k;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// direct filtering of the m_frame
+template<typename T>
+void Convolver<T>::do_direct(value_type *y, size_type n) const
+{
+	const size_type M = m_coef.size();
+	const value_type *h = &m_coef[0];
+
+	for (size_type i = 0; i < n; ++i)
+	{
+		// y[i] = sum h[j]*x[i-j]
+		const value_type *x = &m_frame[i + M-1];
+
+		T res_re = T(), res_im = T();
+		for (size_type j = 0; j < M; ++j)
+		{
+			const value_type &a = h[j];
+			const value_type &b = *(x - j);
+
+			res_re += a.real()*b.real() - a.imag()*b.imag();
+			res_im += a.real()*b.imag() + a.imag()*b.real();
+		}
+
+		y[i] = value_type(res_re, res_im);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// overlap-save filtering of the m_frame
+template<typename T>
+void Convolver<T>::do_fft(value_type *y, size_type n)
+{
+	const size_type M = m_coef.size();
+	const size_type N = m_dft.size();
+
+	// the partial block is padded by zeros
+	std::copy(m_frame.begin(),
+		m_frame.begin() + (M-1+n),
+		m_work.begin());
+	std::fill(m_work.begin() + (M-1+n),
+		m_work.end(), value_type());
+
+	m_dft.forward(m_work);
+	for (size_type i = 0; i < N; ++i)
+		m_work[i] *= m_spectrum[i];
+	m_dft.inverse(m_work);
+
+	// the first M-1 samples are circular aliased
+	std::copy(m_work.begin() + (M-1),
+		m_work.begin() + (M-1+n), y);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+template class Convolver<double>;
+template class Convolver<float>;
+
+	} // dsp namespace
+} // omni namespace
@@ -0,0 +1,120 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Fast convolution and correlation
+	@author Sergey Polichnoy
+*/
+#ifndef __OMNI_CONV_H_
+#define __OMNI_CONV_H_
+
+#include <omni/dsp/DFT.h>
+
+#include <complex>
+#include <vector>
+
+#include <assert.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+
+//////////////////////////////////////////////////////////////////////////
+// block convolver
+/*
+		The streaming FIR filter y[i] = sum h[k]*x[i-k] for long
+	impulse responses. The input is processed in blocks of any length,
+	the filter state is kept between the calls (as FIR_Filter does).
+
+		Each block is filtered directly or by overlap-save with the
+	precomputed filter spectrum, the cheapest method is selected by
+	the cost model for the current block length.
+
+		The correlation mode computes y[i] = sum conj(p[k])*x[i-M+1+k]
+	i.e. the correlation of the last M inputs with the pattern p,
+	the peak is at the last sample of the pattern (preamble detection).
+*/
+template<typename T>
+class Convolver {
+	typedef Convolver<T> this_type;
+
+public:
+	typedef std::complex<T> value_type;
+	typedef size_t size_type;
+	typedef T scalar_type;
+
+	// operation mode
+	enum Mode
+	{
+		CONVOLUTION, // h is the impulse response
+		CORRELATION  // h is the pattern
+	};
+
+public:
+	template<typename In>
+	Convolver(In first, In last, Mode mode = CONVOLUTION)
+		: m_coef(first, last),
+		  m_dft(fft_size(m_coef.size()), scalar_type(1), scalar_type(1))
+	{
+		init(mode);
+	}
+
+public:
+	// filter the block (in-place is allowed)
+	template<typename A>
+	void process(const std::vector<value_type, A> &x, std::vector<value_type, A> &y)
+	{
+		y.resize(x.size());
+		if (!x.empty())
+			process(&x[0], &y[0], x.size());
+	}
+	void process(const value_type *x, value_type *y, size_type n);
+
+	// clear the filter state
+	void reset();
+
+public:
+	// number of coefficients
+	size_type size() const
+	{
+		return m_coef.size();
+	}
+
+	// FFT block size
+	size_type fft_size() const
+	{
+		return m_dft.size();
+	}
+
+	// use FFT for n-samples block?
+	bool is_fft(size_type n) const;
+
+private:
+	static size_type fft_size(size_type N_coef);
+	void init(Mode mode);
+
+	void do_direct(value_type *y, size_type n) const;
+	void do_fft(value_type *y, size_type n);
+
+private:
+	std::vector<value_type> m_coef;    // impulse response (reversed pattern)
+	DFT<T> m_dft;                      // FFT of fft_size() points
+	std::vector<value_type> m_spectrum; // scaled filter spectrum
+	std::vector<value_type> m_frame;   // [history, block, zeros]
+	std::vector<value_type> m_work;    // FFT buffer
+};
+
+	} // dsp namespace
+} // omni namespace
+
+#endif // __OMNI_CONV_H_
@@ -0,0 +1,279 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Arbitrary ratio resampling: Farrow structure
+	@author Sergey Polichnoy
+*/
+#include <omni/dsp/farrow.h>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <math.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+		namespace details
+		{
+
+// @brief Lagrange tables c[p*taps + j]
+const double FARROW_LINEAR[2*2] =
+{
+	1.0, 0.0,
+	-1.0, 1.0
+};
+
+const double FARROW_CUBIC[4*4] =
+{
+	0.0, 1.0, 0.0, 0.0,
+	-1.0/3, -1.0/2, 1.0, -1.0/6,
+	1.0/2, -1.0, 1.0/2, 0.0,
+	-1.0/6, 1.0/2, -1.0/2, 1.0/6
+};
+
+
+// @brief tap weights (common version)
+/*
+		w[j*n + i] = sum_p c[p*K + j] * mu[i]^p (Horner scheme)
+	for outputs [first, n).
+*/
+template<typename T>
+void farrow_weights_T(const T *mu, size_t n, const T *c,
+	size_t K, size_t P, T *w, size_t first)
+{
+	for (size_t j = 0; j < K; ++j)
+	for (size_t i = first; i < n; ++i)
+	{
+		T a = c[P*K + j];
+		for (size_t p = P; 0 < p; --p)
+			a = a*mu[i] + c[(p-1)*K + j];
+		w[j*n + i] = a;
+	}
+}
+
+
+// @brief tap weights (SSE2 version, double)
+/*
+		Two outputs per register.
+*/
+void farrow_weights_SSE2(const double *mu, size_t n, const double *c,
+	size_t K, size_t P, double *w, size_t)
+{
+	size_t i = 0;
+	for (; i+2 <= n; i += 2)
+	{
+		const __m128d m = _mm_loadu_pd(mu + i);
+		for (size_t j = 0; j < K; ++j)
+		{
+			__m128d a = _mm_set1_pd(c[P*K + j]);
+			for (size_t p = P; 0 < p; --p)
+				a = _mm_add_pd(_mm_mul_pd(a, m),
+					_mm_set1_pd(c[(p-1)*K + j]));
+			_mm_storeu_pd(w + j*n + i, a);
+		}
+	}
+
+	farrow_weights_T(mu, n, c, K, P, w, i);
+}
+
+
+// @brief tap weights (SSE2 version, float)
+/*
+		Four outputs per register.
+*/
+void farrow_weights_SSE2(const float *mu, size_t n, const float *c,
+	size_t K, size_t P, float *w, size_t)
+{
+	size_t i = 0;
+	for (; i+4 <= n; i += 4)
+	{
+		const __m128 m = _mm_loadu_ps(mu + i);
+		for (size_t j = 0; j < K; ++j)
+		{
+			__m128 a = _mm_set1_ps(c[P*K + j]);
+			for (size_t p = P; 0 < p; --p)
+				a = _mm_add_ps(_mm_mul_ps(a, m),
+					_mm_set1_ps(c[(p-1)*K + j]));
+			_mm_storeu_ps(w + j*n + i, a);
+		}
+	}
+
+	farrow_weights_T(mu, n, c, K, P, w, i);
+}
+
+
+// @brief tap weights
+template<typename T>
+void farrow_weights(const T *mu, size_t n, const T *c, size_t K, size_t P, T *w)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(const T*, size_t, const T*, size_t, size_t, T*, size_t);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::SSE2)
+				return &farrow_weights_SSE2;
+
+			return &farrow_weights_T<T>;
+		}
+	};
+
+	static typename Aux::FuncPtr run = Aux::select();
+
+	run(mu, n, c, K, P, w, 0);
+}
+
+		} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// construction (built-in polynomial)
+template<typename T, typename CF>
+Farrow<T, CF>::Farrow(double ratio, Polynomial type)
+{
+	const double *c = details::FARROW_CUBIC;
+	m_taps = 4;
+
+	if (LINEAR == type)
+	{
+		c = details::FARROW_LINEAR;
+		m_taps = 2;
+	}
+
+	m_coef.assign(c, c + m_taps*m_taps);
+	init(ratio);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// construction (custom polynomial)
+template<typename T, typename CF>
+Farrow<T, CF>::Farrow(const std::vector<coef_type> &coef, size_type taps, double ratio)
+	: m_coef(coef), m_taps(taps)
+{
+	assert(0 < taps && !coef.empty() && 0 == coef.size()%taps
+		&& "invalid polynomial table");
+
+	init(ratio);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// initialization
+template<typename T, typename CF>
+void Farrow<T, CF>::init(double ratio)
+{
+	set_ratio(ratio);
+	m_hist.resize(m_taps-1);
+	reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// clear the samples
+/*
+		The first output is at the first input sample,
+	i.e. at the history end minus the center offset D.
+*/
+template<typename T, typename CF>
+void Farrow<T, CF>::reset()
+{
+	std::fill(m_hist.begin(),
+		m_hist.end(), value_type());
+	m_time = double(m_taps-1 - (m_taps-1)/2);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// maximum number of outputs for n inputs
+template<typename T, typename CF>
+typename Farrow<T, CF>::size_type Farrow<T, CF>::max_output(size_type n) const
+{
+	return size_type(ceil(n / m_step)) + 1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// resample the block
+/*
+		The time is counted from the work buffer start, the output
+	uses the taps [floor(time), floor(time) + taps), so it is ready
+	while floor(time) < n. The positions are collected first, then
+	the weights of all outputs are evaluated together.
+*/
+template<typename T, typename CF>
+typename Farrow<T, CF>::size_type Farrow<T, CF>::filter(const value_type *in, size_type n, value_type *out)
+{
+	const size_type K = m_taps;
+	if (0 == n)
+		return 0;
+
+	// history: oldest first
+	m_work.resize(K-1 + n);
+	std::copy(m_hist.begin(), m_hist.end(), m_work.begin());
+	std::copy(in, in+n, m_work.begin() + (K-1));
+
+	// output positions
+	m_index.clear();
+	m_mu.clear();
+
+	double t = m_time;
+	for (; t < double(n); t += m_step)
+	{
+		const size_type base = size_type(t);
+		m_index.push_back(base);
+		m_mu.push_back(coef_type(t - base));
+	}
+	m_time = t - double(n);
+	const size_type count = m_index.size();
+
+	// weights and dot products
+	if (0 < count)
+	{
+		m_weight.resize(K*count);
+		details::farrow_weights(&m_mu[0], count,
+			&m_coef[0], K, order(), &m_weight[0]);
+
+		const value_type *x = &m_work[0];
+		const coef_type *w = &m_weight[0];
+		for (size_type i = 0; i < count; ++i)
+		{
+			const value_type *xi = x + m_index[i];
+
+			value_type y = xi[0] * w[i];
+			for (size_type j = 1; j < K; ++j)
+				y += xi[j] * w[j*count + i];
+			out[i] = y;
+		}
+	}
+
+	std::copy(m_work.end() - (K-1),
+		m_work.end(), m_hist.begin());
+
+	return count;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+template class Farrow<double, double>;
+template class Farrow<float, float>;
+template class Farrow<std::complex<double>, double>;
+template class Farrow<std::complex<float>, float>;
+
+	} // dsp namespace
+} // omni namespace
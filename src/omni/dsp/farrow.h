@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Arbitrary ratio resampling: Farrow structure
+	@author Sergey Polichnoy
+*/
+#ifndef __OMNI_FARROW_H_
+#define __OMNI_FARROW_H_
+
+#include <omni/defs.hpp>
+
+#include <complex>
+#include <vector>
+
+#include <assert.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+
+//////////////////////////////////////////////////////////////////////////
+// Farrow resampler
+/*
+		The output sample at the fractional time n + mu (0 <= mu < 1,
+	in input samples) is the polynomial in mu:
+
+		y = sum_p mu^p * sum_j c[p][j] * x[n - D + j],
+
+	where j = 0..taps-1 and D = (taps-1)/2. The built-in tables are
+	Lagrange interpolators (LINEAR: x[n], x[n+1]; CUBIC: x[n-1]..x[n+2]).
+	The custom table is given as c[p*taps + j], p = 0..order.
+
+		The ratio is the output to input sampling rate. It may be
+	changed between blocks: the output time is accumulated, so the
+	phase is continuous. The first output is at the time of the first
+	input sample. The samples are fed by blocks of any length, so the
+	resampler may follow FIR_Filter or FIR_Resampler.
+*/
+template<typename T, typename CF>
+class Farrow {
+	typedef Farrow<T, CF> this_type;
+
+public:
+	typedef T value_type;
+	typedef CF coef_type;
+	typedef size_t size_type;
+
+	// built-in polynomial
+	enum Polynomial
+	{
+		LINEAR,
+		CUBIC
+	};
+
+public:
+	explicit Farrow(double ratio, Polynomial type = CUBIC);
+	Farrow(const std::vector<coef_type> &coef, size_type taps, double ratio);
+
+public:
+	// resample the block, returns the number of outputs
+	size_type filter(const value_type *in, size_type n, value_type *out);
+
+	template<typename A>
+	void filter(const std::vector<value_type, A> &in, std::vector<value_type, A> &out)
+	{
+		out.resize(max_output(in.size()));
+		if (!in.empty())
+			out.resize(filter(&in[0], in.size(), out.empty() ? 0 : &out[0]));
+	}
+
+	// maximum number of outputs for n inputs
+	size_type max_output(size_type n) const;
+
+	// clear the samples
+	void reset();
+
+public:
+	// output to input rate
+	double ratio() const
+	{
+		return 1.0 / m_step;
+	}
+
+	// change the rate (for the next block)
+	void set_ratio(double ratio)
+	{
+		assert(0.0 < ratio && "invalid ratio");
+		m_step = 1.0 / ratio;
+	}
+
+	// number of taps
+	size_type taps() const
+	{
+		return m_taps;
+	}
+
+	// polynomial order
+	size_type order() const
+	{
+		return m_coef.size() / m_taps - 1;
+	}
+
+private:
+	void init(double ratio);
+
+private:
+	std::vector<coef_type> m_coef;   // c[p*taps + j]
+	size_type m_taps;
+
+	double m_step;                   // input samples per output
+	double m_time;                   // next output in the next block
+
+	std::vector<value_type> m_hist;  // taps-1 previous samples
+	std::vector<value_type> m_work;  // block: history and input
+	std::vector<size_type> m_index;  // block: first tap of the outputs
+	std::vector<coef_type> m_mu;     // block: fractional times
+	std::vector<coef_type> m_weight; // block: tap weights w[j*count + i]
+};
+
+	} // dsp namespace
+} // omni namespace
+
+#endif // __OMNI_FARROW_H_
@@ -17,6 +17,17 @@
 */
 #include <omni/dsp/filter.h>
 #include <omni/util.hpp>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__)
+	// AVX code is compiled without global -mavx option
+#	define FILTER_AVX_TARGET __attribute__((target("avx")))
+#else
+#	define FILTER_AVX_TARGET
+#endif
 
 namespace omni
 {
@@ -141,6 +152,519 @@ namespace omni
 		return std::complex<float>(res_re, res_im);
 	}
 
+
+	// block filtering: several outputs per pass,
+	// the coefficient is broadcast, the samples are
+	// loaded at consecutive offsets (register reuse)
+
+	// double * double (SSE2): 8 outputs
+	void filter_block_SSE2(const double *x, const double *h, size_t N, double *y, size_t n)
+	{
+		size_t i = 0;
+		for (; i+8 <= n; i += 8)
+		{
+			__m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+			__m128d a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+
+			const double *px = x + i;
+			for (size_t j = 0; j < N; ++j, ++px)
+			{
+				const __m128d c = _mm_set1_pd(h[j]);
+				a0 = _mm_add_pd(a0, _mm_mul_pd(c, _mm_loadu_pd(px)));
+				a1 = _mm_add_pd(a1, _mm_mul_pd(c, _mm_loadu_pd(px+2)));
+				a2 = _mm_add_pd(a2, _mm_mul_pd(c, _mm_loadu_pd(px+4)));
+				a3 = _mm_add_pd(a3, _mm_mul_pd(c, _mm_loadu_pd(px+6)));
+			}
+
+			_mm_storeu_pd(y+i,   a0);
+			_mm_storeu_pd(y+i+2, a1);
+			_mm_storeu_pd(y+i+4, a2);
+			_mm_storeu_pd(y+i+6, a3);
+		}
+
+		filter_block_T(x+i, h, N, y+i, n-i);
+	}
+
+	// float * float (SSE2): 8 outputs
+	void filter_block_SSE2(const float *x, const float *h, size_t N, float *y, size_t n)
+	{
+		size_t i = 0;
+		for (; i+8 <= n; i += 8)
+		{
+			__m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+
+			const float *px = x + i;
+			for (size_t j = 0; j < N; ++j, ++px)
+			{
+				const __m128 c = _mm_set1_ps(h[j]);
+				a0 = _mm_add_ps(a0, _mm_mul_ps(c, _mm_loadu_ps(px)));
+				a1 = _mm_add_ps(a1, _mm_mul_ps(c, _mm_loadu_ps(px+4)));
+			}
+
+			_mm_storeu_ps(y+i,   a0);
+			_mm_storeu_ps(y+i+4, a1);
+		}
+
+		filter_block_T(x+i, h, N, y+i, n-i);
+	}
+
+	// complex<double> * double (SSE2): 4 outputs
+	void filter_block_SSE2(const std::complex<double> *x, const double *h, size_t N, std::complex<double> *y, size_t n)
+	{
+		size_t i = 0;
+		for (; i+4 <= n; i += 4)
+		{
+			__m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+			__m128d a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+
+			const double *px = reinterpret_cast<const double*>(x + i);
+			for (size_t j = 0; j < N; ++j, px += 2)
+			{
+				const __m128d c = _mm_set1_pd(h[j]);
+				a0 = _mm_add_pd(a0, _mm_mul_pd(c, _mm_loadu_pd(px)));
+				a1 = _mm_add_pd(a1, _mm_mul_pd(c, _mm_loadu_pd(px+2)));
+				a2 = _mm_add_pd(a2, _mm_mul_pd(c, _mm_loadu_pd(px+4)));
+				a3 = _mm_add_pd(a3, _mm_mul_pd(c, _mm_loadu_pd(px+6)));
+			}
+
+			double *py = reinterpret_cast<double*>(y + i);
+			_mm_storeu_pd(py,   a0);
+			_mm_storeu_pd(py+2, a1);
+			_mm_storeu_pd(py+4, a2);
+			_mm_storeu_pd(py+6, a3);
+		}
+
+		filter_block_T(x+i, h, N, y+i, n-i);
+	}
+
+	// complex<float> * float (SSE2): 8 outputs
+	void filter_block_SSE2(const std::complex<float> *x, const float *h, size_t N, std::complex<float> *y, size_t n)
+	{
+		size_t i = 0;
+		for (; i+8 <= n; i += 8)
+		{
+			__m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+			__m128 a2 = _mm_setzero_ps(), a3 = _mm_setzero_ps();
+
+			const float *px = reinterpret_cast<const float*>(x + i);
+			for (size_t j = 0; j < N; ++j, px += 2)
+			{
+				const __m128 c = _mm_set1_ps(h[j]);
+				a0 = _mm_add_ps(a0, _mm_mul_ps(c, _mm_loadu_ps(px)));
+				a1 = _mm_add_ps(a1, _mm_mul_ps(c, _mm_loadu_ps(px+4)));
+				a2 = _mm_add_ps(a2, _mm_mul_ps(c, _mm_loadu_ps(px+8)));
+				a3 = _mm_add_ps(a3, _mm_mul_ps(c, _mm_loadu_ps(px+12)));
+			}
+
+			float *py = reinterpret_cast<float*>(y + i);
+			_mm_storeu_ps(py,    a0);
+			_mm_storeu_ps(py+4,  a1);
+			_mm_storeu_ps(py+8,  a2);
+			_mm_storeu_ps(py+12, a3);
+		}
+
+		filter_block_T(x+i, h, N, y+i, n-i);
+	}
+
+	// complex<double> * complex<double> (SSE2): 2 outputs
+	/*
+			The real and imaginary parts of the coefficient are
+		accumulated separately: y = sum(h_re*x) + j*sum(h_im*x).
+	*/
+	void filter_block_SSE2(const std::complex<double> *x, const std::complex<double> *h, size_t N, std::complex<double> *y, size_t n)
+	{
+		const __m128d neg = _mm_setr_pd(-0.0, 0.0);
+
+		size_t i = 0;
+		for (; i+2 <= n; i += 2)
+		{
+			__m128d r0 = _mm_setzero_pd(), r1 = _mm_setzero_pd();
+			__m128d i0 = _mm_setzero_pd(), i1 = _mm_setzero_pd();
+
+			const double *px = reinterpret_cast<const double*>(x + i);
+			for (size_t j = 0; j < N; ++j, px += 2)
+			{
+				const __m128d c_re = _mm_set1_pd(h[j].real());
+				const __m128d c_im = _mm_set1_pd(h[j].imag());
+				const __m128d x0 = _mm_loadu_pd(px);
+				const __m128d x1 = _mm_loadu_pd(px+2);
+
+				r0 = _mm_add_pd(r0, _mm_mul_pd(c_re, x0));
+				r1 = _mm_add_pd(r1, _mm_mul_pd(c_re, x1));
+				i0 = _mm_add_pd(i0, _mm_mul_pd(c_im, x0));
+				i1 = _mm_add_pd(i1, _mm_mul_pd(c_im, x1));
+			}
+
+			// j*(a + j*b) = -b + j*a
+			i0 = _mm_xor_pd(_mm_shuffle_pd(i0, i0, 1), neg);
+			i1 = _mm_xor_pd(_mm_shuffle_pd(i1, i1, 1), neg);
+
+			double *py = reinterpret_cast<double*>(y + i);
+			_mm_storeu_pd(py,   _mm_add_pd(r0, i0));
+			_mm_storeu_pd(py+2, _mm_add_pd(r1, i1));
+		}
+
+		filter_block_T(x+i, h, N, y+i, n-i);
+	}
+
+	// complex<float> * complex<float> (SSE2): 4 outputs
+	void filter_block_SSE2(const std::complex<float> *x, const std::complex<float> *h, size_t N, std::complex<float> *y, size_t n)
+	{
+		const __m128 neg = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+		size_t i = 0;
+		for (; i+4 <= n; i += 4)
+		{
+			__m128 r0 = _mm_setzero_ps(), r1 = _mm_setzero_ps();
+			__m128 i0 = _mm_setzero_ps(), i1 = _mm_setzero_ps();
+
+			const float *px = reinterpret_cast<const float*>(x + i);
+			for (size_t j = 0; j < N; ++j, px += 2)
+			{
+				const __m128 c_re = _mm_set1_ps(h[j].real());
+				const __m128 c_im = _mm_set1_ps(h[j].imag());
+				const __m128 x0 = _mm_loadu_ps(px);
+				const __m128 x1 = _mm_loadu_ps(px+4);
+
+				r0 = _mm_add_ps(r0, _mm_mul_ps(c_re, x0));
+				r1 = _mm_add_ps(r1, _mm_mul_ps(c_re, x1));
+				i0 = _mm_add_ps(i0, _mm_mul_ps(c_im, x0));
+				i1 = _mm_add_ps(i1, _mm_mul_ps(c_im, x1));
+			}
+
+			// j*(a + j*b) = -b + j*a
+			i0 = _mm_xor_ps(_mm_shuffle_ps(i0, i0, _MM_SHUFFLE(2,3,0,1)), neg);
+			i1 = _mm_xor_ps(_mm_shuffle_ps(i1, i1, _MM_SHUFFLE(2,3,0,1)), neg);
+
+			float *py = reinterpret_cast<float*>(y + i);
+			_mm_storeu_ps(py,   _mm_add_ps(r0, i0));
+			_mm_storeu_ps(py+4, _mm_add_ps(r1, i1));
+		}
+
+		filter_block_T(x+i, h, N, y+i, n-i);
+	}
+
+	// double * double
+	void filter_block(const double *x, const double *h, size_t N, double *y, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const double*, const double*, size_t, double*, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::SSE2)
+					return &filter_block_SSE2;
+
+				return &filter_block_T< double, double >;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(x, h, N, y, n);
+	}
+
+	// float * float
+	void filter_block(const float *x, const float *h, size_t N, float *y, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const float*, const float*, size_t, float*, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::SSE2)
+					return &filter_block_SSE2;
+
+				return &filter_block_T< float, float >;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(x, h, N, y, n);
+	}
+
+	// complex<double> * double
+	void filter_block(const std::complex<double> *x, const double *h, size_t N, std::complex<double> *y, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const std::complex<double>*, const double*, size_t, std::complex<double>*, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::SSE2)
+					return &filter_block_SSE2;
+
+				return &filter_block_T< std::complex<double>, double >;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(x, h, N, y, n);
+	}
+
+	// complex<float> * float
+	void filter_block(const std::complex<float> *x, const float *h, size_t N, std::complex<float> *y, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const std::complex<float>*, const float*, size_t, std::complex<float>*, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::SSE2)
+					return &filter_block_SSE2;
+
+				return &filter_block_T< std::complex<float>, float >;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(x, h, N, y, n);
+	}
+
+	// complex<double> * complex<double>
+	void filter_block(const std::complex<double> *x, const std::complex<double> *h, size_t N, std::complex<double> *y, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const std::complex<double>*, const std::complex<double>*, size_t, std::complex<double>*, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::SSE2)
+					return &filter_block_SSE2;
+
+				return &filter_block_T< std::complex<double>, std::complex<double> >;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(x, h, N, y, n);
+	}
+
+	// complex<float> * complex<float>
+	void filter_block(const std::complex<float> *x, const std::complex<float> *h, size_t N, std::complex<float> *y, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const std::complex<float>*, const std::complex<float>*, size_t, std::complex<float>*, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::SSE2)
+					return &filter_block_SSE2;
+
+				return &filter_block_T< std::complex<float>, std::complex<float> >;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(x, h, N, y, n);
+	}
+
+
+	// double: two channels per register
+	struct IIR_SSE2_D {
+		typedef double value_type;
+		typedef __m128d reg_type;
+		enum { W = 2 };
+
+		static reg_type set1(double a) { return _mm_set1_pd(a); }
+		static reg_type load(const double *p) { return _mm_loadu_pd(p); }
+		static void store(double *p, reg_type a) { _mm_storeu_pd(p, a); }
+		static reg_type add(reg_type a, reg_type b) { return _mm_add_pd(a, b); }
+		static reg_type sub(reg_type a, reg_type b) { return _mm_sub_pd(a, b); }
+		static reg_type mul(reg_type a, reg_type b) { return _mm_mul_pd(a, b); }
+	};
+
+	// float: four channels per register
+	struct IIR_SSE2_F {
+		typedef float value_type;
+		typedef __m128 reg_type;
+		enum { W = 4 };
+
+		static reg_type set1(float a) { return _mm_set1_ps(a); }
+		static reg_type load(const float *p) { return _mm_loadu_ps(p); }
+		static void store(float *p, reg_type a) { _mm_storeu_ps(p, a); }
+		static reg_type add(reg_type a, reg_type b) { return _mm_add_ps(a, b); }
+		static reg_type sub(reg_type a, reg_type b) { return _mm_sub_ps(a, b); }
+		static reg_type mul(reg_type a, reg_type b) { return _mm_mul_ps(a, b); }
+	};
+
+	// double: four channels per register
+	struct IIR_AVX_D {
+		typedef double value_type;
+		typedef __m256d reg_type;
+		typedef IIR_SSE2_D tail_type;
+		enum { W = 4 };
+
+		static FILTER_AVX_TARGET reg_type set1(double a) { return _mm256_set1_pd(a); }
+		static FILTER_AVX_TARGET reg_type load(const double *p) { return _mm256_loadu_pd(p); }
+		static FILTER_AVX_TARGET void store(double *p, reg_type a) { _mm256_storeu_pd(p, a); }
+		static FILTER_AVX_TARGET reg_type add(reg_type a, reg_type b) { return _mm256_add_pd(a, b); }
+		static FILTER_AVX_TARGET reg_type sub(reg_type a, reg_type b) { return _mm256_sub_pd(a, b); }
+		static FILTER_AVX_TARGET reg_type mul(reg_type a, reg_type b) { return _mm256_mul_pd(a, b); }
+	};
+
+	// float: eight channels per register
+	struct IIR_AVX_F {
+		typedef float value_type;
+		typedef __m256 reg_type;
+		typedef IIR_SSE2_F tail_type;
+		enum { W = 8 };
+
+		static FILTER_AVX_TARGET reg_type set1(float a) { return _mm256_set1_ps(a); }
+		static FILTER_AVX_TARGET reg_type load(const float *p) { return _mm256_loadu_ps(p); }
+		static FILTER_AVX_TARGET void store(float *p, reg_type a) { _mm256_storeu_ps(p, a); }
+		static FILTER_AVX_TARGET reg_type add(reg_type a, reg_type b) { return _mm256_add_ps(a, b); }
+		static FILTER_AVX_TARGET reg_type sub(reg_type a, reg_type b) { return _mm256_sub_ps(a, b); }
+		static FILTER_AVX_TARGET reg_type mul(reg_type a, reg_type b) { return _mm256_mul_ps(a, b); }
+	};
+
+
+	// IIR cascade (SSE2 version)
+	/*
+			W channels per register, the coefficients are broadcast,
+		the section state is kept in registers during the block.
+	*/
+	template<typename V>
+		void iir_block_SSE2(const typename V::value_type *coef, size_t S, typename V::value_type *z,
+			size_t C, const typename V::value_type *in, typename V::value_type *out, size_t n, size_t first)
+	{
+		typedef typename V::value_type value_type;
+		typedef typename V::reg_type reg_type;
+
+		size_t c = first;
+		for (; c + V::W <= C; c += V::W)
+		for (size_t s = 0; s < S; ++s)
+		{
+			const reg_type b0 = V::set1(coef[s]), b1 = V::set1(coef[S+s]), b2 = V::set1(coef[2*S+s]);
+			const reg_type a1 = V::set1(coef[3*S+s]), a2 = V::set1(coef[4*S+s]);
+
+			reg_type z1 = V::load(z + 2*s*C + c);
+			reg_type z2 = V::load(z + (2*s+1)*C + c);
+			const value_type *x = s ? out : in;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const reg_type xi = V::load(x + i*C + c);
+				const reg_type y = V::add(V::mul(b0, xi), z1);
+				z1 = V::add(V::sub(V::mul(b1, xi), V::mul(a1, y)), z2);
+				z2 = V::sub(V::mul(b2, xi), V::mul(a2, y));
+				V::store(out + i*C + c, y);
+			}
+			V::store(z + 2*s*C + c, z1);
+			V::store(z + (2*s+1)*C + c, z2);
+		}
+
+		iir_block_T(coef, S, z, C, in, out, n, c);
+	}
+
+	// IIR cascade (AVX version)
+	template<typename V> FILTER_AVX_TARGET
+		void iir_block_AVX(const typename V::value_type *coef, size_t S, typename V::value_type *z,
+			size_t C, const typename V::value_type *in, typename V::value_type *out, size_t n, size_t)
+	{
+		typedef typename V::value_type value_type;
+		typedef typename V::reg_type reg_type;
+
+		size_t c = 0;
+		for (; c + V::W <= C; c += V::W)
+		for (size_t s = 0; s < S; ++s)
+		{
+			const reg_type b0 = V::set1(coef[s]), b1 = V::set1(coef[S+s]), b2 = V::set1(coef[2*S+s]);
+			const reg_type a1 = V::set1(coef[3*S+s]), a2 = V::set1(coef[4*S+s]);
+
+			reg_type z1 = V::load(z + 2*s*C + c);
+			reg_type z2 = V::load(z + (2*s+1)*C + c);
+			const value_type *x = s ? out : in;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const reg_type xi = V::load(x + i*C + c);
+				const reg_type y = V::add(V::mul(b0, xi), z1);
+				z1 = V::add(V::sub(V::mul(b1, xi), V::mul(a1, y)), z2);
+				z2 = V::sub(V::mul(b2, xi), V::mul(a2, y));
+				V::store(out + i*C + c, y);
+			}
+			V::store(z + 2*s*C + c, z1);
+			V::store(z + (2*s+1)*C + c, z2);
+		}
+
+		_mm256_zeroupper();
+
+		// the rest channels: SSE2 lanes, then one by one
+		iir_block_SSE2<typename V::tail_type>(coef, S, z, C, in, out, n, c);
+	}
+
+	// double
+	void iir_block(const double *coef, size_t S, double *z, size_t C, const double *in, double *out, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const double*, size_t, double*, size_t, const double*, double*, size_t, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::AVX)
+					return &iir_block_AVX<IIR_AVX_D>;
+				if (SIMD::Capability::SSE2)
+					return &iir_block_SSE2<IIR_SSE2_D>;
+
+				return &iir_block_T<double, double>;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(coef, S, z, C, in, out, n, 0);
+	}
+
+	// float
+	void iir_block(const float *coef, size_t S, float *z, size_t C, const float *in, float *out, size_t n)
+	{
+		// auxiliary
+		struct Aux {
+			typedef void (*FuncPtr)(const float*, size_t, float*, size_t, const float*, float*, size_t, size_t);
+
+			static FuncPtr select()
+			{
+				if (SIMD::Capability::AVX)
+					return &iir_block_AVX<IIR_AVX_F>;
+				if (SIMD::Capability::SSE2)
+					return &iir_block_SSE2<IIR_SSE2_F>;
+
+				return &iir_block_T<float, float>;
+			}
+		};
+
+		static Aux::FuncPtr run = Aux::select();
+
+		run(coef, S, z, C, in, out, n, 0);
+	}
+
+	// complex<double>: real and imaginary parts are two channels
+	void iir_block(const double *coef, size_t S, std::complex<double> *z, size_t C, const std::complex<double> *in, std::complex<double> *out, size_t n)
+	{
+		iir_block(coef, S, reinterpret_cast<double*>(z), 2*C,
+			reinterpret_cast<const double*>(in),
+			reinterpret_cast<double*>(out), n);
+	}
+
+	// complex<float>: real and imaginary parts are two channels
+	void iir_block(const float *coef, size_t S, std::complex<float> *z, size_t C, const std::complex<float> *in, std::complex<float> *out, size_t n)
+	{
+		iir_block(coef, S, reinterpret_cast<float*>(z), 2*C,
+			reinterpret_cast<const float*>(in),
+			reinterpret_cast<float*>(out), n);
+	}
+
 		} // details namespace
 
 
@@ -378,6 +902,20 @@ const_reference operator()(const_reference x)
 @return Фильтрованный отсчет
 */
 
+//////////////////////////////////////////////////////////////////////////
+/** @fn void FIR_Filter<T, CF>::filter(const T *in, T *out, size_type n)
+
+		Метод фильтрует блок из @a n отсчетов @a in, результат записывается
+	в @a out (допускается in == out). Результат совпадает с поотсчетной
+	фильтрацией operator(), но предыдущие отсчеты и блок копируются
+	в непрерывный буфер, поэтому выходы вычисляются векторными
+	скалярными произведениями (SIMD) без кольцевой адресации.
+
+@param in Входные отсчеты
+@param out Фильтрованные отсчеты
+@param n Количество отсчетов
+*/
+
 //////////////////////////////////////////////////////////////////////////
 /** @fn size_type FIR_Filter<T, CF>::size() const
 
@@ -405,5 +943,53 @@ const_reference operator()(const_reference x)
 @return Итератор за последний коэффициент
 */
 
+
+//////////////////////////////////////////////////////////////////////////
+/** @class IIR_Filter
+
+		Класс IIR_Filter реализует БИХ-фильтр в виде каскада биквадратных
+	секций в прямой транспонированной форме II:
+
+@code
+y  = b0*x + z1;
+z1 = b1*x - a1*y + z2;
+z2 = b2*x - a2*y;
+@endcode
+
+		Коэффициенты задаются по шесть на секцию: b0 b1 b2 a0 a1 a2
+	(формат second-order sections) и нормируются на a0. Внутри фильтра
+	коэффициенты хранятся раздельными массивами (b0 всех секций,
+	b1 всех секций и т.д.), состояния секций - аналогично по каналам.
+
+		Фильтр может обрабатывать несколько независимых каналов
+	с одинаковыми коэффициентами. Отсчеты каналов чередуются:
+	in[i*channels() + c]. Каналы обрабатываются параллельно
+	в SIMD регистрах (4 или 8 каналов float при SSE2 и AVX),
+	комплексный отсчет с вещественными коэффициентами
+	считается двумя каналами.
+
+@code
+const double sos[] = { 0.2, 0.4, 0.2, 1.0, -0.3, 0.1 };
+IIR_Filter<float, float> f(sos, sos+6, 8); // 8 каналов
+f.filter(in, out, n); // n отсчетов каждого канала
+@endcode
+
+		Конструктор по умолчанию создает всепропускающий фильтр.
+
+@author Сергей Поличной
+*/
+
+//////////////////////////////////////////////////////////////////////////
+/** @fn void IIR_Filter<T, CF>::filter(const T *in, T *out, size_type n)
+
+		Метод фильтрует блок из @a n отсчетов каждого канала @a in,
+	результат записывается в @a out (допускается in == out).
+	Секции обрабатываются поочередно по всему блоку.
+
+@param in Входные отсчеты (каналы чередуются)
+@param out Фильтрованные отсчеты
+@param n Количество отсчетов каждого канала
+*/
+
 	} // dsp namespace
 } // omni namespace
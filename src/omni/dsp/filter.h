@@ -22,9 +22,12 @@
 
 #include <omni/defs.hpp>
 
+#include <algorithm>
 #include <complex>
 #include <vector>
 
+#include <assert.h>
+
 namespace omni
 {
 	namespace dsp
@@ -62,6 +65,8 @@ template<typename T, typename CF>
 	public: // ()
 		value_type operator()(const_reference x); ///< @brief Фильтровать значение
 
+		void filter(const T *in, T *out, size_type n); ///< @brief Фильтровать блок отсчетов
+
 		// only put
 		void put(const_reference x)
 		{
@@ -105,6 +110,156 @@ template<typename T, typename CF>
 		basic_type m_xbuf;
 		coef_array m_coef;
 		size_type  m_wpos;
+
+		basic_type m_work;  // block: history and input
+		coef_array m_rcoef; // block: reversed coefficients
+	};
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Полифазный КИХ-фильтр с передискретизацией
+/**
+		Фильтр эквивалентен цепочке: вставка L-1 нулей между отсчетами,
+	КИХ-фильтр с заданными коэффициентами и прореживание в M раз.
+	Вычисляются только остающиеся выходные отсчеты.
+*/
+template<typename T, typename CF>
+	class FIR_Resampler {
+		typedef std::vector<CF> coef_array;
+		typedef std::vector<T> basic_type;
+
+	public: /// @name Определения типов
+		typedef typename basic_type::value_type value_type;              ///< @brief Тип отсчета
+		typedef typename basic_type::size_type   size_type;              ///< @brief Тип индексов и размера
+
+	public: /// @name Конструкторы
+		template<typename In>
+			FIR_Resampler(In first, In last, size_type L, size_type M)  /// @brief Создать фильтр с заданными коэффициентами
+				: m_L(L), m_M(M)
+				{ __init(coef_array(first, last)); }
+
+	public: /// @name Фильтрация
+		size_type filter(const T *in, size_type n, T *out); ///< @brief Фильтровать блок отсчетов
+
+		template<typename A>
+			void filter(const std::vector<T, A> &in, std::vector<T, A> &out) /// @brief Фильтровать блок отсчетов
+		{
+			out.resize(max_output(in.size()));
+			if (!in.empty())
+				out.resize(filter(&in[0], in.size(), out.empty() ? 0 : &out[0]));
+		}
+
+		size_type max_output(size_type n) const; ///< @brief Максимальное количество выходных отсчетов
+		void reset();                            ///< @brief Обнулить фильтр
+
+	public: /// @name Параметры
+		size_type L() const { return m_L; } ///< @brief Коэффициент интерполяции
+		size_type M() const { return m_M; } ///< @brief Коэффициент децимации
+
+	private:
+		void __init(const coef_array &coef);
+
+	private:
+		size_type m_L, m_M;
+		size_type m_K;       // length of the phase filter
+		coef_array m_rcoef;  // phase filters (reversed): L x K
+		coef_array m_scoef;  // decimation: stream filters M x K/M
+
+		basic_type m_hist;   // K-1 previous samples
+		size_type  m_time;   // next output time (upsampled) in the next block
+
+		basic_type m_work;   // block: history and input
+		basic_type m_tmp;    // block: phase outputs
+		basic_type m_stream; // block: decimated input stream
+	};
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Полифазный интерполятор
+template<typename T, typename CF>
+	class FIR_Interpolator: public FIR_Resampler<T, CF> {
+	public:
+		template<typename In>
+			FIR_Interpolator(In first, In last, size_t L)     /// @brief Создать интерполятор в L раз
+				: FIR_Resampler<T, CF>(first, last, L, 1)
+		{}
+	};
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Полифазный дециматор
+template<typename T, typename CF>
+	class FIR_Decimator: public FIR_Resampler<T, CF> {
+	public:
+		template<typename In>
+			FIR_Decimator(In first, In last, size_t M)        /// @brief Создать дециматор в M раз
+				: FIR_Resampler<T, CF>(first, last, 1, M)
+		{}
+	};
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief БИХ-фильтр (каскад биквадратных секций)
+template<typename T, typename CF>
+	class IIR_Filter {
+		typedef std::vector<CF> coef_array;
+		typedef std::vector<T> basic_type;
+
+	public: /// @name Определения типов
+		typedef typename basic_type::const_reference const_reference;    ///< @brief Константная ссылка на отсчет
+		typedef typename basic_type::value_type value_type;              ///< @brief Тип отсчета
+		typedef typename basic_type::size_type   size_type;              ///< @brief Тип индексов и размера
+
+	public: /// @name Конструкторы
+		IIR_Filter();
+
+		template<typename In>
+			IIR_Filter(In first, In last, size_type channels = 1) /// @brief Создать фильтр с заданными секциями
+				{ __init(first, last, channels); }
+
+	public: /// @name Размер и содержимое
+		size_type size() const;            ///< @brief Количество секций
+		size_type channels() const;        ///< @brief Количество каналов
+
+		void reset();                      ///< @brief Обнулить фильтр
+
+	public: // ()
+		value_type operator()(const_reference x); ///< @brief Фильтровать значение
+
+		void filter(const T *in, T *out, size_type n); ///< @brief Фильтровать блок отсчетов
+
+	private: // initialization
+		template<typename In>
+			void __init(In first, In last, size_type channels)
+		{
+			const coef_array sos(first, last);
+			assert(0 == sos.size()%6 && 0 < channels
+				&& "invalid second-order sections");
+
+			// SoA: b0[S], b1[S], b2[S], a1[S], a2[S]
+			const size_type S = sos.size() / 6;
+			m_coef.resize(5*S);
+			for (size_type s = 0; s < S; ++s)
+			{
+				const CF *c = &sos[6*s];
+				m_coef[0*S + s] = c[0] / c[3];
+				m_coef[1*S + s] = c[1] / c[3];
+				m_coef[2*S + s] = c[2] / c[3];
+				m_coef[3*S + s] = c[4] / c[3];
+				m_coef[4*S + s] = c[5] / c[3];
+			}
+
+			m_S = S;
+			m_C = channels;
+			m_state.resize(2*S*channels);
+			reset();
+		}
+
+	private:
+		coef_array m_coef;  // SoA coefficients
+		basic_type m_state; // z1, z2 of the sections: [s][2][C]
+		size_type  m_S;     // number of sections
+		size_type  m_C;     // number of channels
 	};
 
 
@@ -150,6 +305,79 @@ namespace details
 	std::complex<float> filter_dot(const std::vector< std::complex<float> > &xbuf,
 		const std::vector<float> &coef, size_t wpos, size_t N);
 
+
+	// block filtering: y[i] = sum h[j]*x[i+j], j < N (common implementation)
+	template<typename T, typename CF>
+		void filter_block_T(const T *x, const CF *h, size_t N, T *y, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			T res(h[0] * x[i]);
+			for (size_t j = 1; j < N; ++j)
+				res += h[j] * x[i+j];
+			y[i] = res;
+		}
+	}
+
+	// general
+	template<typename T, typename CF> inline
+		void filter_block(const T *x, const CF *h, size_t N, T *y, size_t n)
+	{
+		filter_block_T(x, h, N, y, n);
+	}
+
+	// automatic (SIMD)
+	void filter_block(const double *x, const double *h, size_t N, double *y, size_t n);
+	void filter_block(const float *x, const float *h, size_t N, float *y, size_t n);
+	void filter_block(const std::complex<double> *x, const double *h, size_t N, std::complex<double> *y, size_t n);
+	void filter_block(const std::complex<float> *x, const float *h, size_t N, std::complex<float> *y, size_t n);
+	void filter_block(const std::complex<double> *x, const std::complex<double> *h, size_t N, std::complex<double> *y, size_t n);
+	void filter_block(const std::complex<float> *x, const std::complex<float> *h, size_t N, std::complex<float> *y, size_t n);
+
+
+	// IIR cascade: S sections, C interleaved channels [first, C) (common implementation)
+	/*
+			Direct form II transposed, the sections are processed
+		one by one over the whole block (in place for s > 0).
+	*/
+	template<typename T, typename CF>
+		void iir_block_T(const CF *coef, size_t S, T *z, size_t C,
+			const T *in, T *out, size_t n, size_t first)
+	{
+		for (size_t c = first; c < C; ++c)
+		for (size_t s = 0; s < S; ++s)
+		{
+			const CF b0 = coef[s], b1 = coef[S+s], b2 = coef[2*S+s];
+			const CF a1 = coef[3*S+s], a2 = coef[4*S+s];
+
+			T z1 = z[2*s*C + c], z2 = z[(2*s+1)*C + c];
+			const T *x = s ? out : in;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const T xi = x[i*C + c];
+				const T y = b0*xi + z1;
+				z1 = b1*xi - a1*y + z2;
+				z2 = b2*xi - a2*y;
+				out[i*C + c] = y;
+			}
+			z[2*s*C + c] = z1;
+			z[(2*s+1)*C + c] = z2;
+		}
+	}
+
+	// general
+	template<typename T, typename CF> inline
+		void iir_block(const CF *coef, size_t S, T *z, size_t C, const T *in, T *out, size_t n)
+	{
+		iir_block_T(coef, S, z, C, in, out, n, 0);
+	}
+
+	// automatic (SIMD, channels in lanes)
+	void iir_block(const double *coef, size_t S, double *z, size_t C, const double *in, double *out, size_t n);
+	void iir_block(const float *coef, size_t S, float *z, size_t C, const float *in, float *out, size_t n);
+	void iir_block(const double *coef, size_t S, std::complex<double> *z, size_t C, const std::complex<double> *in, std::complex<double> *out, size_t n);
+	void iir_block(const float *coef, size_t S, std::complex<float> *z, size_t C, const std::complex<float> *in, std::complex<float> *out, size_t n);
+
 } // details namespace
 
 
@@ -198,6 +426,46 @@ template<typename T, typename CF>
 	return x; // transparent
 }
 
+// filter the block of samples
+/*
+		The N-1 previous samples and the block are copied to the
+	contiguous buffer, so the outputs are plain dot products with
+	the reversed coefficients. Then the ring buffer is restored.
+*/
+template<typename T, typename CF>
+	void FIR_Filter<T, CF>::filter(const T *in, T *out, size_type n)
+{
+	const size_type N = size();
+
+	if (0 == N)
+	{
+		std::copy(in, in+n, out);
+		return; // transparent
+	}
+	if (0 == n)
+		return;
+
+	// history: oldest first
+	m_work.resize(N-1 + n);
+	size_type k = (m_wpos+1 == N) ? 0 : m_wpos+1; // the newest
+	for (size_type j = 0; j+1 < N; ++j)
+	{
+		m_work[N-2-j] = m_xbuf[k];
+		if (++k == N)
+			k = 0;
+	}
+	std::copy(in, in+n,
+		m_work.begin() + (N-1));
+
+	m_rcoef.assign(m_coef.rbegin(), m_coef.rend());
+	details::filter_block(&m_work[0], &m_rcoef[0], N, out, n);
+
+	// the last N samples: the newest at 0
+	for (size_type j = 0; j < N; ++j)
+		m_xbuf[j] = m_work[N-2+n-j];
+	m_wpos = N-1;
+}
+
 // get filter size
 template<typename T, typename CF> inline
 	typename FIR_Filter<T, CF>::size_type FIR_Filter<T, CF>::size() const
@@ -233,6 +501,199 @@ template<typename T, typename CF> inline
 	return m_coef.end();
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+// IIR Filter implementation
+
+// transparent filter
+template<typename T, typename CF>
+	IIR_Filter<T, CF>::IIR_Filter()
+		: m_S(0), m_C(1)
+{}
+
+// clear the sections state
+template<typename T, typename CF>
+	void IIR_Filter<T, CF>::reset()
+{
+	std::fill(m_state.begin(),
+		m_state.end(), value_type());
+}
+
+// number of sections
+template<typename T, typename CF> inline
+	typename IIR_Filter<T, CF>::size_type IIR_Filter<T, CF>::size() const
+{
+	return m_S;
+}
+
+// number of channels
+template<typename T, typename CF> inline
+	typename IIR_Filter<T, CF>::size_type IIR_Filter<T, CF>::channels() const
+{
+	return m_C;
+}
+
+// put value to filter
+template<typename T, typename CF>
+	typename IIR_Filter<T, CF>::value_type IIR_Filter<T, CF>::operator()(const_reference x)
+{
+	assert(1 == m_C && "single channel only");
+
+	value_type y = x;
+	if (0 < m_S)
+		details::iir_block_T(&m_coef[0], m_S,
+			&m_state[0], 1, &x, &y, 1, 0);
+
+	return y;
+}
+
+// filter the block of samples
+template<typename T, typename CF>
+	void IIR_Filter<T, CF>::filter(const T *in, T *out, size_type n)
+{
+	if (0 == m_S)
+	{
+		std::copy(in, in + n*m_C, out);
+		return; // transparent
+	}
+	if (0 == n)
+		return;
+
+	details::iir_block(&m_coef[0], m_S,
+		&m_state[0], m_C, in, out, n);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// FIR resampler implementation
+
+// initialization
+/*
+		The coefficients are padded by zeros to the multiple of L
+	(and of M for decimation). The phase p filter is h[p + j*L].
+*/
+template<typename T, typename CF>
+	void FIR_Resampler<T, CF>::__init(const coef_array &coef)
+{
+	assert(0 < m_L && 0 < m_M && "invalid resampling factors");
+	assert(!coef.empty() && "no coefficients");
+
+	const size_type step = (1 == m_L) ? m_M : m_L;
+	coef_array h(coef);
+	h.resize((coef.size() + step-1) / step * step, CF());
+
+	m_K = h.size() / m_L;
+	m_rcoef.resize(m_L*m_K);
+	for (size_type p = 0; p < m_L; ++p)
+	for (size_type i = 0; i < m_K; ++i)
+		m_rcoef[p*m_K + i] = h[p + (m_K-1-i)*m_L];
+
+	// decimation: stream r filter is rcoef[r + s*M]
+	if (1 == m_L && 1 < m_M)
+	{
+		const size_type S = m_K / m_M;
+		m_scoef.resize(m_K);
+		for (size_type r = 0; r < m_M; ++r)
+		for (size_type k = 0; k < S; ++k)
+			m_scoef[r*S + k] = m_rcoef[r + k*m_M];
+	}
+
+	m_hist.resize(m_K-1);
+	reset();
+}
+
+// clear the filter
+template<typename T, typename CF>
+	void FIR_Resampler<T, CF>::reset()
+{
+	std::fill(m_hist.begin(),
+		m_hist.end(), value_type());
+	m_time = 0;
+}
+
+// maximum number of outputs
+template<typename T, typename CF> inline
+	typename FIR_Resampler<T, CF>::size_type FIR_Resampler<T, CF>::max_output(size_type n) const
+{
+	return (n*m_L + m_M-1) / m_M;
+}
+
+// filter the block of samples
+/*
+		The output at time t (upsampled) uses the phase p = t%L
+	and the input q = t/L. The interpolation is done phase by phase,
+	the decimation - by M input streams, so the outputs are the
+	consecutive dot products (details::filter_block).
+*/
+template<typename T, typename CF>
+	typename FIR_Resampler<T, CF>::size_type FIR_Resampler<T, CF>::filter(const T *in, size_type n, T *out)
+{
+	const size_type K = m_K, L = m_L, M = m_M;
+	if (0 == n)
+		return 0;
+
+	// history: oldest first
+	m_work.resize(K-1 + n);
+	std::copy(m_hist.begin(), m_hist.end(), m_work.begin());
+	std::copy(in, in+n, m_work.begin() + (K-1));
+	const T *w = &m_work[0];
+
+	size_type count = 0;
+	if (1 == M)
+	{
+		// interpolation: all phases
+		m_tmp.resize(n);
+		for (size_type p = 0; p < L; ++p)
+		{
+			details::filter_block(w, &m_rcoef[p*K], K, &m_tmp[0], n);
+			for (size_type q = 0; q < n; ++q)
+				out[q*L + p] = m_tmp[q];
+		}
+
+		count = n*L;
+	}
+	else if (1 == L)
+	{
+		// decimation: y[k] = sum_r sum_s g_r[s]*w[t0 + r + (k+s)*M]
+		const size_type t0 = m_time;
+		const size_type S = K / M;
+		count = (t0 < n) ? (n - t0 + M-1) / M : 0;
+
+		if (0 < count)
+		{
+			m_tmp.resize(count);
+			m_stream.resize(count + S-1);
+			std::fill(out, out+count, value_type());
+
+			for (size_type r = 0; r < M; ++r)
+			{
+				for (size_type j = 0; j < m_stream.size(); ++j)
+					m_stream[j] = w[t0 + r + j*M];
+
+				details::filter_block(&m_stream[0], &m_scoef[r*S], S, &m_tmp[0], count);
+				for (size_type k = 0; k < count; ++k)
+					out[k] += m_tmp[k];
+			}
+		}
+
+		m_time = t0 + count*M - n;
+	}
+	else
+	{
+		// rational: output by output
+		size_type t = m_time;
+		for (; t < n*L; t += M, ++count)
+			details::filter_block(w + t/L, &m_rcoef[(t%L)*K], K, out + count, 1);
+
+		m_time = t - n*L;
+	}
+
+	std::copy(m_work.end() - (K-1),
+		m_work.end(), m_hist.begin());
+
+	return count;
+}
+
 	} // dsp namespace
 } // omni namespace
 
@@ -0,0 +1,301 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Power spectral density estimation
+	@author Sergey Polichnoy
+*/
+#include <omni/dsp/psd.h>
+#include <omni/util.hpp>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <math.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+		namespace details
+		{
+
+// number of segments transformed in batch
+const size_t PSD_BATCH = 8;
+
+
+// @brief window function (periodic)
+template<typename T>
+std::vector<T> psd_window(size_t N, int type)
+{
+	std::vector<T> w(N, T(1));
+
+	for (size_t n = 0; n < N; ++n)
+	{
+		const double a = 2.0 * util::PI * n / N;
+
+		switch (type)
+		{
+			case Welch<T>::HANN:
+				w[n] = T(0.5 - 0.5*cos(a));
+				break;
+
+			case Welch<T>::HAMMING:
+				w[n] = T(0.54 - 0.46*cos(a));
+				break;
+
+			case Welch<T>::BLACKMAN:
+				w[n] = T(0.42 - 0.5*cos(a) + 0.08*cos(2*a));
+				break;
+		}
+	}
+
+	return w;
+}
+
+
+// @brief acc[k] += |x[k]|^2 (common version)
+template<typename T>
+void psd_norm_acc_T(T *acc, const std::complex<T> *x, size_t N)
+{
+	for (size_t k = 0; k < N; ++k)
+		acc[k] += x[k].real()*x[k].real() + x[k].imag()*x[k].imag();
+}
+
+
+// @brief acc[k] += |x[k]|^2 (SSE2 version, double)
+/*
+		Two complex samples per iteration: squares are
+	split to real and imaginary parts and added.
+*/
+void psd_norm_acc_SSE2(double *acc, const std::complex<double> *x, size_t N)
+{
+	const double *px = reinterpret_cast<const double*>(x);
+
+	size_t k = 0;
+	for (; k+2 <= N; k += 2)
+	{
+		const __m128d a = _mm_loadu_pd(px + 2*k);   // r0 i0
+		const __m128d b = _mm_loadu_pd(px + 2*k+2); // r1 i1
+
+		const __m128d a2 = _mm_mul_pd(a, a);
+		const __m128d b2 = _mm_mul_pd(b, b);
+
+		const __m128d n = _mm_add_pd(
+			_mm_unpacklo_pd(a2, b2),
+			_mm_unpackhi_pd(a2, b2));
+
+		_mm_storeu_pd(acc + k, _mm_add_pd(_mm_loadu_pd(acc + k), n));
+	}
+
+	psd_norm_acc_T(acc + k, x + k, N - k);
+}
+
+
+// @brief acc[k] += |x[k]|^2 (SSE2 version, float)
+/*
+		Four complex samples per iteration.
+*/
+void psd_norm_acc_SSE2(float *acc, const std::complex<float> *x, size_t N)
+{
+	const float *px = reinterpret_cast<const float*>(x);
+
+	size_t k = 0;
+	for (; k+4 <= N; k += 4)
+	{
+		const __m128 a = _mm_loadu_ps(px + 2*k);   // r0 i0 r1 i1
+		const __m128 b = _mm_loadu_ps(px + 2*k+4); // r2 i2 r3 i3
+
+		const __m128 a2 = _mm_mul_ps(a, a);
+		const __m128 b2 = _mm_mul_ps(b, b);
+
+		const __m128 n = _mm_add_ps(
+			_mm_shuffle_ps(a2, b2, _MM_SHUFFLE(2,0,2,0)),
+			_mm_shuffle_ps(a2, b2, _MM_SHUFFLE(3,1,3,1)));
+
+		_mm_storeu_ps(acc + k, _mm_add_ps(_mm_loadu_ps(acc + k), n));
+	}
+
+	psd_norm_acc_T(acc + k, x + k, N - k);
+}
+
+
+// @brief acc[k] += |x[k]|^2
+template<typename T>
+void psd_norm_acc(T *acc, const std::complex<T> *x, size_t N)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(T*, const std::complex<T>*, size_t);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::SSE2)
+				return &psd_norm_acc_SSE2;
+
+			return &psd_norm_acc_T<T>;
+		}
+	};
+
+	static typename Aux::FuncPtr run = Aux::select();
+
+	run(acc, x, N);
+}
+
+		} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// Welch construction
+template<typename T>
+Welch<T>::Welch(size_type N, size_type overlap, Window window)
+	: m_dft(N, scalar_type(1), scalar_type(1)),
+	  m_window(details::psd_window<T>(N, window))
+{
+	init(overlap);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Welch construction (custom window)
+template<typename T>
+Welch<T>::Welch(const std::vector<scalar_type> &window, size_type overlap)
+	: m_dft(window.size(), scalar_type(1), scalar_type(1)),
+	  m_window(window)
+{
+	init(overlap);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// initialization
+template<typename T>
+void Welch<T>::init(size_type overlap)
+{
+	const size_type N = m_dft.size();
+	assert(0 < N && overlap < N
+		&& "invalid segment overlap");
+
+	m_step = N - overlap;
+	m_segment.resize(N);
+	m_batch.resize(details::PSD_BATCH*N);
+	m_sum.resize(N);
+
+	reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// clear all segments
+template<typename T>
+void Welch<T>::reset()
+{
+	std::fill(m_sum.begin(),
+		m_sum.end(), scalar_type());
+
+	m_fill = 0;
+	m_pending = 0;
+	m_count = 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// put samples
+template<typename T>
+void Welch<T>::put(const value_type *x, size_type n)
+{
+	const size_type N = m_dft.size();
+
+	while (0 < n)
+	{
+		const size_type k = std::min(n, N - m_fill);
+		std::copy(x, x+k, m_segment.begin() + m_fill);
+		m_fill += k;
+		x += k;
+		n -= k;
+
+		if (m_fill < N)
+			break;
+
+		// windowed segment to the batch
+		value_type *y = &m_batch[m_pending*N];
+		for (size_type i = 0; i < N; ++i)
+			y[i] = m_segment[i] * m_window[i];
+		if (++m_pending == details::PSD_BATCH)
+			flush();
+
+		// keep the overlapped part
+		std::copy(m_segment.begin() + m_step,
+			m_segment.end(), m_segment.begin());
+		m_fill = N - m_step;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// transform pending segments
+template<typename T>
+void Welch<T>::flush()
+{
+	if (0 == m_pending)
+		return;
+
+	const size_type N = m_dft.size();
+	m_dft.forward_batch(&m_batch[0], m_pending, N);
+
+	for (size_type i = 0; i < m_pending; ++i)
+		details::psd_norm_acc(&m_sum[0], &m_batch[i*N], N);
+
+	m_count += m_pending;
+	m_pending = 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// get PSD estimate
+template<typename T>
+void Welch<T>::psd(std::vector<scalar_type> &out)
+{
+	const size_type N = m_dft.size();
+	flush();
+
+	double U = 0.0;
+	for (size_type i = 0; i < N; ++i)
+		U += double(m_window[i]) * m_window[i];
+
+	const scalar_type scale = m_count ? scalar_type(1.0 / (U*m_count)) : scalar_type();
+
+	out.resize(N);
+	for (size_type k = 0; k < N; ++k)
+		out[k] = m_sum[k] * scale;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// get PSD estimate
+template<typename T>
+std::vector<typename Welch<T>::scalar_type> Welch<T>::psd()
+{
+	std::vector<scalar_type> out;
+	psd(out);
+	return out;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+template class Welch<double>;
+template class Welch<float>;
+
+	} // dsp namespace
+} // omni namespace
@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Power spectral density estimation
+	@author Sergey Polichnoy
+*/
+#ifndef __OMNI_PSD_H_
+#define __OMNI_PSD_H_
+
+#include <omni/dsp/DFT.h>
+
+#include <complex>
+#include <vector>
+
+#include <assert.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+
+//////////////////////////////////////////////////////////////////////////
+// Welch PSD estimator
+/*
+		The averaged periodogram of the overlapped windowed segments.
+	The samples are fed by blocks of any length, the complete segments
+	are collected and transformed in batch. Only the sum of the
+	periodograms is kept, so the capture may be of any length.
+
+		The estimate is two-sided and normalized to the unit sampling
+	rate: psd[k] = sum |X_k|^2 / (K * sum w^2), where K is the number
+	of segments. The white noise of variance s^2 gives psd[k] = s^2.
+*/
+template<typename T>
+class Welch {
+	typedef Welch<T> this_type;
+
+public:
+	typedef std::complex<T> value_type;
+	typedef size_t size_type;
+	typedef T scalar_type;
+
+	// window type
+	enum Window
+	{
+		RECTANGULAR,
+		HANN,
+		HAMMING,
+		BLACKMAN
+	};
+
+public:
+	Welch(size_type N, size_type overlap, Window window = HANN);
+	Welch(const std::vector<scalar_type> &window, size_type overlap);
+
+public:
+	// put samples
+	template<typename A>
+	void put(const std::vector<value_type, A> &x)
+	{
+		if (!x.empty())
+			put(&x[0], x.size());
+	}
+	void put(const value_type *x, size_type n);
+
+	// get PSD estimate
+	std::vector<scalar_type> psd();
+	void psd(std::vector<scalar_type> &out);
+
+	// clear all segments
+	void reset();
+
+public:
+	// segment size
+	size_type size() const
+	{
+		return m_dft.size();
+	}
+
+	// number of complete segments
+	size_type count() const
+	{
+		return m_count + m_pending;
+	}
+
+private:
+	void init(size_type overlap);
+	void flush();
+
+private:
+	DFT<T> m_dft;                       // segment transform
+	std::vector<scalar_type> m_window;  // window
+	size_type m_step;                   // segment step
+
+	std::vector<value_type> m_segment;  // current segment
+	size_type m_fill;                   // number of samples in m_segment
+
+	std::vector<value_type> m_batch;    // windowed segments
+	size_type m_pending;                // number of segments in m_batch
+
+	std::vector<scalar_type> m_sum;     // sum of periodograms
+	size_type m_count;                  // number of summed segments
+};
+
+	} // dsp namespace
+} // omni namespace
+
+#endif // __OMNI_PSD_H_
@@ -0,0 +1,315 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Tone tracking: sliding DFT and Goertzel bank
+	@author Sergey Polichnoy
+*/
+#include <omni/dsp/tone.h>
+#include <omni/util.hpp>
+#include <omni/SIMD.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <math.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+		namespace details
+		{
+
+// @brief Goertzel recursion (common version)
+/*
+		s[n] = x[n] + c*s[n-1] - s[n-2] for bins [first, last),
+	the states are kept in registers during the samples loop.
+*/
+template<typename T>
+void goertzel_run_T(const std::complex<T> *x, size_t n, const T *c,
+	T *s1_re, T *s1_im, T *s2_re, T *s2_im, size_t first, size_t last)
+{
+	for (size_t k = first; k < last; ++k)
+	{
+		T a_re = s1_re[k], a_im = s1_im[k];
+		T b_re = s2_re[k], b_im = s2_im[k];
+		const T ck = c[k];
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const T t_re = x[i].real() + ck*a_re - b_re;
+			const T t_im = x[i].imag() + ck*a_im - b_im;
+			b_re = a_re; a_re = t_re;
+			b_im = a_im; a_im = t_im;
+		}
+
+		s1_re[k] = a_re; s1_im[k] = a_im;
+		s2_re[k] = b_re; s2_im[k] = b_im;
+	}
+}
+
+
+// @brief Goertzel recursion (SSE2 version, double)
+/*
+		Two bins per register.
+*/
+void goertzel_run_SSE2(const std::complex<double> *x, size_t n, const double *c,
+	double *s1_re, double *s1_im, double *s2_re, double *s2_im, size_t first, size_t last)
+{
+	size_t k = first;
+	for (; k+2 <= last; k += 2)
+	{
+		__m128d a_re = _mm_loadu_pd(s1_re + k), a_im = _mm_loadu_pd(s1_im + k);
+		__m128d b_re = _mm_loadu_pd(s2_re + k), b_im = _mm_loadu_pd(s2_im + k);
+		const __m128d ck = _mm_loadu_pd(c + k);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const __m128d t_re = _mm_sub_pd(_mm_add_pd(_mm_set1_pd(x[i].real()),
+				_mm_mul_pd(ck, a_re)), b_re);
+			const __m128d t_im = _mm_sub_pd(_mm_add_pd(_mm_set1_pd(x[i].imag()),
+				_mm_mul_pd(ck, a_im)), b_im);
+			b_re = a_re; a_re = t_re;
+			b_im = a_im; a_im = t_im;
+		}
+
+		_mm_storeu_pd(s1_re + k, a_re); _mm_storeu_pd(s1_im + k, a_im);
+		_mm_storeu_pd(s2_re + k, b_re); _mm_storeu_pd(s2_im + k, b_im);
+	}
+
+	goertzel_run_T(x, n, c, s1_re, s1_im, s2_re, s2_im, k, last);
+}
+
+
+// @brief Goertzel recursion (SSE2 version, float)
+/*
+		Four bins per register.
+*/
+void goertzel_run_SSE2(const std::complex<float> *x, size_t n, const float *c,
+	float *s1_re, float *s1_im, float *s2_re, float *s2_im, size_t first, size_t last)
+{
+	size_t k = first;
+	for (; k+4 <= last; k += 4)
+	{
+		__m128 a_re = _mm_loadu_ps(s1_re + k), a_im = _mm_loadu_ps(s1_im + k);
+		__m128 b_re = _mm_loadu_ps(s2_re + k), b_im = _mm_loadu_ps(s2_im + k);
+		const __m128 ck = _mm_loadu_ps(c + k);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const __m128 t_re = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(x[i].real()),
+				_mm_mul_ps(ck, a_re)), b_re);
+			const __m128 t_im = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(x[i].imag()),
+				_mm_mul_ps(ck, a_im)), b_im);
+			b_re = a_re; a_re = t_re;
+			b_im = a_im; a_im = t_im;
+		}
+
+		_mm_storeu_ps(s1_re + k, a_re); _mm_storeu_ps(s1_im + k, a_im);
+		_mm_storeu_ps(s2_re + k, b_re); _mm_storeu_ps(s2_im + k, b_im);
+	}
+
+	goertzel_run_T(x, n, c, s1_re, s1_im, s2_re, s2_im, k, last);
+}
+
+
+// @brief Goertzel recursion
+template<typename T>
+void goertzel_run(const std::complex<T> *x, size_t n, const T *c,
+	T *s1_re, T *s1_im, T *s2_re, T *s2_im, size_t K)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(const std::complex<T>*, size_t, const T*,
+			T*, T*, T*, T*, size_t, size_t);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::SSE2)
+				return &goertzel_run_SSE2;
+
+			return &goertzel_run_T<T>;
+		}
+	};
+
+	static typename Aux::FuncPtr run = Aux::select();
+
+	run(x, n, c, s1_re, s1_im, s2_re, s2_im, 0, K);
+}
+
+		} // details namespace
+
+
+//////////////////////////////////////////////////////////////////////////
+// sliding DFT construction
+template<typename T>
+SlidingDFT<T>::SlidingDFT(size_type N, const std::vector<size_type> &bins)
+	: m_phase(N), m_bins(bins), m_index(bins.size()),
+	  m_sum(bins.size()), m_delay(N)
+{
+	assert(0 < N && "invalid DFT size");
+
+	for (size_type m = 0; m < N; ++m)
+		m_phase[m] = std::polar(scalar_type(1),
+			scalar_type(-2*omni::util::PI*m / N));
+
+	for (size_type i = 0; i < m_bins.size(); ++i)
+		m_bins[i] %= N;
+
+	reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// clear the samples
+template<typename T>
+void SlidingDFT<T>::reset()
+{
+	std::fill(m_delay.begin(),
+		m_delay.end(), value_type());
+	std::fill(m_sum.begin(),
+		m_sum.end(), value_type());
+
+	// the first sample has index 0
+	for (size_type i = 0; i < m_bins.size(); ++i)
+		m_index[i] = 0;
+	m_pos = 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// put samples
+template<typename T>
+void SlidingDFT<T>::put(const value_type *x, size_type n)
+{
+	const size_type N = m_phase.size();
+	const size_type K = m_bins.size();
+
+	for (size_type j = 0; j < n; ++j)
+	{
+		// x[m] enters, x[m-N] leaves with the same phase
+		const value_type d = x[j] - m_delay[m_pos];
+		m_delay[m_pos] = x[j];
+		if (++m_pos == N)
+			m_pos = 0;
+
+		for (size_type i = 0; i < K; ++i)
+		{
+			size_type p = m_index[i];
+			m_sum[i] += d * m_phase[p];
+
+			p += m_bins[i];
+			if (N <= p)
+				p -= N;
+			m_index[i] = p;
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// get all selected bins
+template<typename T>
+void SlidingDFT<T>::get(std::vector<value_type> &X) const
+{
+	const size_type K = m_bins.size();
+
+	X.resize(K);
+	for (size_type i = 0; i < K; ++i)
+		X[i] = (*this)[i];
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Goertzel bank construction
+template<typename T>
+Goertzel<T>::Goertzel(size_type N, const std::vector<double> &bins)
+	: m_size(N), m_omega(bins.size()), m_coef(bins.size()),
+	  m_s1_re(bins.size()), m_s1_im(bins.size()),
+	  m_s2_re(bins.size()), m_s2_im(bins.size())
+{
+	assert(0 < N && "invalid block size");
+
+	for (size_type i = 0; i < bins.size(); ++i)
+	{
+		m_omega[i] = 2*omni::util::PI*bins[i] / N;
+		m_coef[i] = scalar_type(2*cos(m_omega[i]));
+	}
+
+	reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// start the new block
+template<typename T>
+void Goertzel<T>::reset()
+{
+	std::fill(m_s1_re.begin(), m_s1_re.end(), scalar_type());
+	std::fill(m_s1_im.begin(), m_s1_im.end(), scalar_type());
+	std::fill(m_s2_re.begin(), m_s2_re.end(), scalar_type());
+	std::fill(m_s2_im.begin(), m_s2_im.end(), scalar_type());
+	m_count = 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// put samples
+template<typename T>
+void Goertzel<T>::put(const value_type *x, size_type n)
+{
+	if (m_omega.empty() || 0 == n)
+		return;
+
+	details::goertzel_run(x, n, &m_coef[0],
+		&m_s1_re[0], &m_s1_im[0],
+		&m_s2_re[0], &m_s2_im[0],
+		m_omega.size());
+	m_count += n;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// get the DFT values
+/*
+		X(f) = exp(-j*w*(n-1)) * (s[n-1] - exp(-j*w)*s[n-2]),
+	where n is the number of samples put.
+*/
+template<typename T>
+void Goertzel<T>::get(std::vector<value_type> &X) const
+{
+	const size_type K = m_omega.size();
+
+	X.resize(K);
+	for (size_type i = 0; i < K; ++i)
+	{
+		const std::complex<double> s1(m_s1_re[i], m_s1_im[i]);
+		const std::complex<double> s2(m_s2_re[i], m_s2_im[i]);
+		const double w = m_omega[i];
+
+		const std::complex<double> y = s1 - std::polar(1.0, -w)*s2;
+		X[i] = value_type(y * std::polar(1.0, -w*(double(m_count) - 1)));
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+template class SlidingDFT<double>;
+template class SlidingDFT<float>;
+
+template class Goertzel<double>;
+template class Goertzel<float>;
+
+	} // dsp namespace
+} // omni namespace
@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+//////////////////////////////////////////////////////////////////////////
+/** @file
+	@brief Tone tracking: sliding DFT and Goertzel bank
+	@author Sergey Polichnoy
+*/
+#ifndef __OMNI_TONE_H_
+#define __OMNI_TONE_H_
+
+#include <omni/defs.hpp>
+
+#include <complex>
+#include <vector>
+
+#include <assert.h>
+
+namespace omni
+{
+	namespace dsp
+	{
+
+//////////////////////////////////////////////////////////////////////////
+// sliding DFT
+/*
+		The selected bins of the N-points DFT of the last N samples,
+	updated by O(K) operations per sample (K is the number of bins).
+	The result is not scaled (as DFT with unit forward scale).
+
+		The running sums use the absolute sample phase (from the
+	table of N points), so the rounding errors are not amplified
+	by the recursion and no resynchronization is required.
+*/
+template<typename T>
+class SlidingDFT {
+	typedef SlidingDFT<T> this_type;
+
+public:
+	typedef std::complex<T> value_type;
+	typedef size_t size_type;
+	typedef T scalar_type;
+
+public:
+	SlidingDFT(size_type N, const std::vector<size_type> &bins);
+
+public:
+	// put samples
+	template<typename A>
+	void put(const std::vector<value_type, A> &x)
+	{
+		if (!x.empty())
+			put(&x[0], x.size());
+	}
+	void put(const value_type *x, size_type n);
+
+	// clear the samples
+	void reset();
+
+public:
+	// get i-th selected bin
+	value_type operator[](size_type i) const
+	{
+		assert(i < m_bins.size() && "index out of range");
+		return m_sum[i] * std::conj(m_phase[m_index[i]]);
+	}
+
+	// get all selected bins
+	void get(std::vector<value_type> &X) const;
+
+public:
+	// DFT size
+	size_type size() const
+	{
+		return m_phase.size();
+	}
+
+	// number of selected bins
+	size_type Nbins() const
+	{
+		return m_bins.size();
+	}
+
+private:
+	std::vector<value_type> m_phase;  // exp(-j*2*pi*m/N)
+	std::vector<size_type> m_bins;    // bin indices
+	std::vector<size_type> m_index;   // k*(n+1) mod N
+	std::vector<value_type> m_sum;    // sum x[m]*exp(-j*2*pi*k*m/N)
+
+	std::vector<value_type> m_delay;  // last N samples
+	size_type m_pos;                  // the oldest sample
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+// Goertzel bank
+/*
+		The DFT values X(f) = sum x[m]*exp(-j*2*pi*f*m/N) of the
+	block for the selected (possibly fractional) bins f. The block
+	is fed by parts of any length; all bins are updated together
+	by the vectorized second-order recursion.
+*/
+template<typename T>
+class Goertzel {
+	typedef Goertzel<T> this_type;
+
+public:
+	typedef std::complex<T> value_type;
+	typedef size_t size_type;
+	typedef T scalar_type;
+
+public:
+	Goertzel(size_type N, const std::vector<double> &bins);
+
+public:
+	// put samples
+	template<typename A>
+	void put(const std::vector<value_type, A> &x)
+	{
+		if (!x.empty())
+			put(&x[0], x.size());
+	}
+	void put(const value_type *x, size_type n);
+
+	// get the DFT values of the samples put
+	void get(std::vector<value_type> &X) const;
+
+	// start the new block
+	void reset();
+
+public:
+	// nominal block size
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	// number of selected bins
+	size_type Nbins() const
+	{
+		return m_omega.size();
+	}
+
+	// number of samples put
+	size_type count() const
+	{
+		return m_count;
+	}
+
+private:
+	size_type m_size;
+	size_type m_count;
+
+	std::vector<double> m_omega;      // 2*pi*f/N
+	std::vector<scalar_type> m_coef;  // 2*cos(omega)
+
+	// states s[n-1], s[n-2]: real and imaginary parts
+	std::vector<scalar_type> m_s1_re, m_s1_im;
+	std::vector<scalar_type> m_s2_re, m_s2_im;
+};
+
+	} // dsp namespace
+} // omni namespace
+
+#endif // __OMNI_TONE_H_
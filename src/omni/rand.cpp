@@ -17,59 +17,170 @@
 */
 #include <omni/rand.hpp>
 #include <omni/util.hpp>
+#include <omni/SIMD.hpp>
 
 #if OMNI_MT
 #	include <omni/sync.hpp>
 #endif // OMNI_MT
 
+#include <emmintrin.h>
 #include <assert.h>
 #include <math.h>
 #include <time.h>
 
+#include <vector>
+
 // global generators
 namespace
 {
 	using namespace omni::rnd;
 
+#if defined(_MSC_VER)
+	typedef unsigned __int64 UInt64;
+#else
+	typedef unsigned long long UInt64;
+#endif
+
 //////////////////////////////////////////////////////////////////////////
-// @brief The global discrete PRS generator.
-Random& g_rand()
+// @brief The per-thread set of generators.
+/*
+		Each thread has its own set of global generators,
+	so the global functions don't need any synchronization.
+	The generators are seeded by the global seed and thread index.
+*/
+struct ThreadRand
 {
-	static Random DEF;
-	return DEF;
-}
+	Random      rand;
+	Uniform     unif;
+	Normal      norm;
+	Exponential exp;
+	Bits        bits;
 
+	size_t      index; // thread index
+	RandomValue epoch; // seed epoch
+	bool        fixed; // index is set by set_thread_index()
+	bool        busy;  // used by the owner thread
 
-//////////////////////////////////////////////////////////////////////////
-// @brief The global uniform distributed PRS generator.
-Uniform& g_unif()
-{
-	static Uniform DEF;
-	return DEF;
-}
+#if OMNI_MT
+	HANDLE      owner; // owner thread
+#endif // OMNI_MT
+
+	ThreadRand()
+		: index(0), epoch(0),
+		  fixed(false), busy(false)
+	{
+		OMNI_MT_CODE(owner = 0);
+	}
+};
 
 
 //////////////////////////////////////////////////////////////////////////
-// @brief The global normal distributed PRS generator.
-Normal& g_norm()
+// @brief The registry of all per-thread generators.
+/*
+		The generators of the exited thread are given to the next new
+	thread together with its index, so the number of generators
+	and thread indices is limited by the number of simultaneously
+	running threads. The recycled generators are not re-seeded
+	(until the next srand()), i.e. the new thread continues the random
+	sequence of the exited one and doesn't repeat it.
+
+		The thread exit is checked by the owner thread handle
+	on registration of the new thread. All generators are released
+	on exit.
+*/
+class ThreadRandList:
+	private omni::NonCopyable
 {
-	static Normal DEF;
-	return DEF;
-}
+public:
+	ThreadRandList()
+		: m_N_threads(0)
+	{}
+
+	~ThreadRandList()
+	{
+		for (size_t i = 0; i < m_list.size(); ++i)
+		{
+#if OMNI_MT
+			if (m_list[i]->owner)
+				CloseHandle(m_list[i]->owner);
+#endif // OMNI_MT
+			delete m_list[i];
+		}
+	}
+
+public:
+
+	// get generators for the current thread
+	/*
+			The generators of the exited thread are preferred,
+		the "auto" ones if the thread index isn't assigned.
+		Returns true if the generators are recycled.
+	*/
+	bool acquire(ThreadRand *&gen, bool fixed)
+	{
+		gen = 0;
+
+#if OMNI_MT
+		for (size_t i = 0; i < m_list.size(); ++i)
+		{
+			ThreadRand *x = m_list[i];
+			if (x->busy && x->owner && WAIT_OBJECT_0 == WaitForSingleObject(x->owner, 0))
+			{
+				CloseHandle(x->owner); // thread exited
+				x->owner = 0;
+				x->busy = false;
+			}
+
+			if (!x->busy && (!gen || x->fixed == fixed))
+				gen = x;
+		}
+#endif // OMNI_MT
+
+		const bool recycled = (0 != gen);
+		if (!recycled)
+		{
+			gen = new ThreadRand();
+			m_list.push_back(gen);
+		}
+
+#if OMNI_MT
+		// (!) not recycled if failed
+		DuplicateHandle(GetCurrentProcess(), GetCurrentThread(),
+			GetCurrentProcess(), &gen->owner, SYNCHRONIZE, FALSE, 0);
+#endif // OMNI_MT
+
+		gen->busy = true;
+		return recycled;
+	}
+
+	// new thread index
+	size_t next_index()
+	{
+		return m_N_threads++;
+	}
+
+private:
+	std::vector<ThreadRand*> m_list;
+	size_t m_N_threads;
+};
 
 
 //////////////////////////////////////////////////////////////////////////
-// @brief The global exponential distributed PRS generator.
-Exponential& g_exp()
+// @brief The global registry of per-thread generators.
+ThreadRandList& g_list()
 {
-	static Exponential DEF;
-	return DEF;
+	static ThreadRandList LIST;
+	return LIST;
 }
 
 
 #if OMNI_MT
 //////////////////////////////////////////////////////////////////////////
 // @brief The global critical section.
+/*
+		The critical section is used in slow path only:
+	on first call from a new thread or after srand().
+*/
 omni::sync::CriticalSection& g_lock()
 {
 	static omni::sync::CriticalSection LOCK(1024); // (!) spin count
@@ -86,8 +197,326 @@ RandomValue& g_seed()
 	return SEED;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+// @brief The seed epoch.
+/*
+		The epoch is changed by each srand() call.
+	All per-thread generators of the previous epoch
+	will be re-seeded on next usage.
+*/
+volatile RandomValue& g_epoch()
+{
+	static volatile RandomValue EPOCH = 0;
+	return EPOCH;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief The current thread's generators.
+ThreadRand*& t_rand()
+{
+	static OMNI_TLS ThreadRand *GEN = 0;
+	return GEN;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief The current thread's index.
+/*
+		The (-1) means index is not set by set_thread_index().
+*/
+size_t& t_index()
+{
+	static OMNI_TLS size_t INDEX = size_t(-1);
+	return INDEX;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Get the current thread's generators (slow path).
+/*
+		The generators are (re-)seeded if the seed epoch or thread
+	index is changed or if @a force is true.
+*/
+ThreadRand& g_rand_init(bool force)
+{
+	OMNI_MT_CODE(omni::sync::AutoLock guard(g_lock()));
+
+	const size_t fixed_index = t_index();
+	const bool fixed = (size_t(-1) != fixed_index);
+
+	ThreadRand *&gen = t_rand();
+	if (!gen)
+	{
+		// the "auto" index is taken with the recycled generators
+		const bool recycled = g_list().acquire(gen, fixed);
+		if (!recycled || gen->fixed || fixed)
+		{
+			gen->index = fixed ? fixed_index : g_list().next_index();
+			force = true;
+		}
+	}
+
+	const size_t index = fixed ? fixed_index : gen->index;
+	const RandomValue epoch = g_epoch();
+	if (force || gen->epoch != epoch || gen->index != index)
+	{
+		const RandomValue seed = thread_seed(g_seed(), index);
+
+		gen->rand = Random(seed);
+		gen->unif = Uniform(seed);
+		gen->norm = Normal(seed);
+		gen->exp = Exponential(seed);
+		gen->bits = Bits(seed);
+		gen->index = index;
+		gen->epoch = epoch;
+	}
+	gen->fixed = fixed;
+
+	return *gen;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Get the current thread's generators.
+/*
+		The fast path doesn't use any synchronization.
+*/
+inline ThreadRand& g_rand()
+{
+	ThreadRand *gen = t_rand();
+	if (gen && gen->epoch == g_epoch())
+		return *gen;
+
+	return g_rand_init(false);
+}
+
 } // global generators
 
+// MT jump-ahead
+namespace
+{
+
+// MT19937 parameters
+enum
+{
+	MT_MEXP = 19937, // Mersenne exponent
+	MT_N = 624,
+	MT_M = 397,
+
+	MT_NEAR_LOG2 = 15, // near jumps are done step by step
+	MT_HI_PERIOD = MT_N - MT_M // period of high bits (64-bit only)
+};
+
+
+// polynomial over GF(2), bit i is coefficient of t^i
+typedef std::vector<unsigned int> Poly;
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief One step of 32-bit MT recurrence.
+inline unsigned int mt_next(unsigned int x0, unsigned int x1, unsigned int xm)
+{
+	const unsigned int y = (x0&0x80000000U) | (x1&0x7FFFFFFFU);
+	return xm ^ (y >> 1) ^ (y&1 ? 0x9908B0DFU : 0U);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Generate the MT sequence.
+/*
+		The first MT_N words should be initialized.
+*/
+void mt_sequence(std::vector<unsigned int> &seq)
+{
+	for (size_t i = MT_N; i < seq.size(); ++i)
+		seq[i] = mt_next(seq[i-MT_N], seq[i-MT_N+1], seq[i-MT_N+MT_M]);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Get the bit.
+inline unsigned int bit(const Poly &a, size_t i)
+{
+	return (a[i/32] >> (i%32)) & 1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Get the 32 bits starting from arbitrary position.
+inline unsigned int bits32(const Poly &a, size_t i)
+{
+	const size_t w = i/32;
+	const size_t s = i%32;
+
+	if (0 == s)
+		return a[w];
+	else
+		return (a[w] >> s) | (a[w+1] << (32-s));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Add the shifted polynomial: a += b*t^shift.
+void xor_shifted(Poly &a, const Poly &b, size_t b_words, size_t shift)
+{
+	const size_t w = shift/32;
+	const size_t s = shift%32;
+
+	if (0 == s)
+	{
+		for (size_t i = 0; i < b_words; ++i)
+			a[i+w] ^= b[i];
+	}
+	else
+	{
+		a[w] ^= b[0] << s;
+		for (size_t i = 1; i < b_words; ++i)
+			a[i+w] ^= (b[i] << s) | (b[i-1] >> (32-s));
+		if (b_words+w < a.size()) // (!) high bits are zero
+			a[b_words+w] ^= b[b_words-1] >> (32-s);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief The characteristic polynomial of MT19937.
+/*
+		The polynomial is calculated by Berlekamp-Massey algorithm
+	from the 2*MT_MEXP bits of MT sequence.
+*/
+Poly mt_char_poly()
+{
+	const size_t LEN = 2*MT_MEXP;
+	const size_t WORDS = LEN/32 + 2;
+
+	// any non-zero state
+	std::vector<unsigned int> seq(MT_N + MT_N + LEN);
+	seq[0] = 5489U;
+	for (unsigned int i = 1; i < MT_N; ++i)
+		seq[i] = 1812433253U * (seq[i-1] ^ (seq[i-1] >> 30)) + i;
+	mt_sequence(seq);
+
+	// the reversed bit sequence: R[LEN-1-n] = s[n]
+	Poly R(WORDS+1, 0);
+	for (size_t n = 0; n < LEN; ++n)
+		if (seq[MT_N + MT_N + n]&1)
+			R[(LEN-1-n)/32] |= 1U << ((LEN-1-n)%32);
+
+	Poly C(WORDS, 0); C[0] = 1;
+	Poly B(WORDS, 0); B[0] = 1;
+	size_t L = 0, m = 1;
+
+	for (size_t n = 0; n < LEN; ++n)
+	{
+		// discrepancy: sum(C[i]*s[n-i], i=0..L)
+		const size_t base = LEN-1-n;
+		unsigned int d = 0;
+		for (size_t w = 0; w <= L/32; ++w)
+			d ^= C[w] & bits32(R, base + 32*w);
+
+		d ^= d >> 16; d ^= d >> 8;
+		d ^= d >> 4;  d ^= d >> 2;
+		d ^= d >> 1;
+
+		if (0 == (d&1))
+			++m;
+		else if (2*L <= n)
+		{
+			Poly T(C);
+			xor_shifted(C, B, WORDS-1 - (m+31)/32, m);
+			L = n+1 - L;
+			B.swap(T);
+			m = 1;
+		}
+		else
+		{
+			xor_shifted(C, B, WORDS-1 - (m+31)/32, m);
+			++m;
+		}
+	}
+
+	assert(MT_MEXP == L && "invalid MT characteristic polynomial");
+
+	// characteristic polynomial is reversed connection polynomial
+	Poly phi((MT_MEXP+1+31)/32, 0);
+	for (size_t i = 0; i <= L; ++i)
+		if (bit(C, L-i))
+			phi[i/32] |= 1U << (i%32);
+
+	return phi;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Reduce polynomial modulo characteristic polynomial.
+void mt_reduce(Poly &a, const Poly &phi)
+{
+	for (size_t i = 32*a.size(); MT_MEXP < i--; )
+		if (bit(a, i))
+			xor_shifted(a, phi, phi.size(), i - MT_MEXP);
+
+	a.resize(MT_MEXP/32 + 1);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Square polynomial modulo characteristic polynomial.
+Poly mt_sqr(const Poly &a, const Poly &phi)
+{
+	Poly b(2*a.size() + 1, 0);
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		unsigned int lo = a[i] & 0xFFFF;
+		unsigned int hi = a[i] >> 16;
+
+		// spread bits: abcd => 0a0b0c0d
+		lo = (lo | (lo << 8)) & 0x00FF00FFU; hi = (hi | (hi << 8)) & 0x00FF00FFU;
+		lo = (lo | (lo << 4)) & 0x0F0F0F0FU; hi = (hi | (hi << 4)) & 0x0F0F0F0FU;
+		lo = (lo | (lo << 2)) & 0x33333333U; hi = (hi | (hi << 2)) & 0x33333333U;
+		lo = (lo | (lo << 1)) & 0x55555555U; hi = (hi | (hi << 1)) & 0x55555555U;
+
+		b[2*i+0] = lo;
+		b[2*i+1] = hi;
+	}
+
+	mt_reduce(b, phi);
+	return b;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// @brief Get jump polynomial: t^(2^k) mod phi.
+/*
+		The polynomials are calculated once and cached.
+*/
+Poly mt_jump_poly(size_t k)
+{
+	OMNI_MT_CODE(omni::sync::AutoLock guard(g_lock()));
+
+	static Poly PHI;
+	static std::vector<Poly> POW2;
+
+	if (PHI.empty())
+		PHI = mt_char_poly();
+
+	if (POW2.empty())
+	{
+		Poly t(MT_MEXP/32 + 1, 0); t[0] = 2; // t^1
+		POW2.push_back(t);
+	}
+
+	while (POW2.size() <= k)
+		POW2.push_back(mt_sqr(POW2.back(), PHI));
+
+	return POW2[k];
+}
+
+} // MT jump-ahead
+
+
 
 namespace omni
 {
@@ -110,8 +539,7 @@ namespace omni
 */
 RandomValue rand(RandomValue lo, RandomValue up)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_rand()(lo, up);
+	return g_rand().rand(lo, up);
 }
 
 
@@ -125,8 +553,7 @@ RandomValue rand(RandomValue lo, RandomValue up)
 */
 RandomValue rand(RandomValue up)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_rand()(up);
+	return g_rand().rand(up);
 }
 
 
@@ -139,8 +566,7 @@ RandomValue rand(RandomValue up)
 */
 RandomValue rand()
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_rand()();
+	return g_rand().rand();
 }
 
 
@@ -153,7 +579,7 @@ RandomValue rand()
 */
 RandomValue rand_max()
 {
-	return g_rand().rand_max();
+	return Random::rand_max();
 }
 
 
@@ -162,18 +588,90 @@ RandomValue rand_max()
 /**
 		This function initializes all global generators by @a seed value.
 
+		Each thread has its own set of global generators. The generators
+	of thread with index @a k are seeded by thread_seed(@a seed, @a k)
+	value. All threads are re-seeded on the next usage of global
+	generators, so the random sequence of each thread depends on
+	the @a seed and thread index only.
+
 @param seed The seed value of all generators.
+@see thread_seed()
 */
 void srand(RandomValue seed)
 {
 	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
 
-	g_rand() = Random(seed);
-	g_unif() = Uniform(seed);
-	g_norm() = Normal(seed);
-	g_exp() = Exponential(seed);
-
 	g_seed() = seed;
+	g_epoch() += 1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the current thread index.
+/**
+		This function returns the index of the current thread. If
+	index was not assigned by set_thread_index(), then the next
+	free index is used: the first thread which uses global generators
+	has zero index, the second thread has index 1 and so on.
+
+		The index and generators of the exited thread are given to
+	the next new thread, which continues the random sequence of the
+	exited thread. So the thread indices are limited by the number
+	of simultaneously running threads.
+
+@return The thread index.
+*/
+size_t thread_index()
+{
+	return g_rand().index;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Set the current thread index.
+/**
+		This function assigns the @a index to the current thread
+	and re-seeds the thread's global generators. The thread index
+	should be used to get the reproducible random sequences from
+	the worker threads independent on the threads start order.
+
+		Several threads with the same index will produce the same
+	random sequences.
+
+@param index The thread index.
+*/
+void set_thread_index(size_t index)
+{
+	t_index() = index;
+	g_rand_init(true);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the seed value of the thread's generators.
+/**
+		This function calculates the seed value of the global generators
+	for thread with index @a index. The zero thread uses @a seed value
+	as is, so the single-thread application has the same random
+	sequences as before. For all other threads the seed value
+	is scrambled by the integer hash function.
+
+@param seed The global seed value.
+@param index The thread index.
+@return The seed value of thread's generators.
+*/
+RandomValue thread_seed(RandomValue seed, size_t index)
+{
+	if (0 == index)
+		return seed;
+
+	// 32-bit integer hash (see MurmurHash3 finalizer)
+	RandomValue h = (seed ^ (RandomValue(index)*0x9E3779B9UL)) & 0xFFFFFFFFUL;
+	h ^= (h >> 16); h = (h * 0x85EBCA6BUL) & 0xFFFFFFFFUL;
+	h ^= (h >> 13); h = (h * 0xC2B2AE35UL) & 0xFFFFFFFFUL;
+	h ^= (h >> 16);
+
+	return h;
 }
 
 
@@ -205,8 +703,7 @@ RandomValue randomize()
 */
 double runif(double lo, double up)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_unif()(lo, up);
+	return g_rand().unif(lo, up);
 }
 
 
@@ -221,8 +718,7 @@ double runif(double lo, double up)
 */
 double runif(double up)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_unif()(up);
+	return g_rand().unif(up);
 }
 
 
@@ -236,8 +732,7 @@ double runif(double up)
 */
 double runif()
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_unif()();
+	return g_rand().unif();
 }
 
 
@@ -253,8 +748,7 @@ double runif()
 */
 double rnorm(double mean, double stdev)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_norm()(mean, stdev);
+	return g_rand().norm(mean, stdev);
 }
 
 
@@ -269,8 +763,7 @@ double rnorm(double mean, double stdev)
 */
 double rnorm(double stdev)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_norm()(stdev);
+	return g_rand().norm(stdev);
 }
 
 
@@ -284,8 +777,26 @@ double rnorm(double stdev)
 */
 double rnorm()
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_norm()();
+	return g_rand().norm();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the normal distributed random numbers.
+/**
+		This function fills the buffer [@a first, @a first + @a N)
+	by the normal distributed random numbers with standard
+	deviation @a stdev and zero mean.
+
+		It's much faster than the @a N rnorm() calls.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+@param stdev The standard deviation.
+*/
+void rnorm(double *first, size_t N, double stdev)
+{
+	g_rand().norm.fill(first, N, stdev);
 }
 
 
@@ -303,11 +814,12 @@ double rnorm()
 */
 std::complex<double> wgn(double stdev)
 {
+	Uniform &unif = g_rand().unif;
 	double re, im, nrm;
 
 	do {
-		re = rnd::runif(-1.0, +1.0);
-		im = rnd::runif(-1.0, +1.0);
+		re = unif(-1.0, +1.0);
+		im = unif(-1.0, +1.0);
 		nrm = re*re + im*im;
 	} while (0.0==nrm || 1.0<=nrm);
 
@@ -327,8 +839,7 @@ std::complex<double> wgn(double stdev)
 */
 double rexp(double stdev)
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_exp()(stdev);
+	return g_rand().exp(stdev);
 }
 
 
@@ -342,8 +853,37 @@ double rexp(double stdev)
 */
 double rexp()
 {
-	OMNI_MT_CODE(sync::AutoLock guard(g_lock()));
-	return g_exp()();
+	return g_rand().exp();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate packed random bits.
+/**
+		This function generates 64 random bits at one time.
+
+@return The packed random bits.
+@see Bits
+*/
+RandomBits rbits()
+{
+	return g_rand().bits();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate packed random bits.
+/**
+		This function fills the buffer [@a first, @a first + @a N_words)
+	by the packed random bits.
+
+@param first Begin of the output buffer.
+@param N_words The number of words.
+@see Bits
+*/
+void rbits(RandomBits *first, size_t N_words)
+{
+	g_rand().bits.fill(first, N_words);
 }
 
 	} // auxiliary functions
@@ -498,46 +1038,1565 @@ void Random::reload()
 	m_curr = 0;
 }
 
-	} // Random
+//////////////////////////////////////////////////////////////////////////
+/// @brief Jump ahead.
+/**
+		This method moves the generator forward by @a steps random
+	numbers. The result is the same as @a steps calls of the operator()(),
+	but it takes much less time for large @a steps.
 
+		Note, the Uniform generator uses two random numbers per value,
+	so the Uniform generator should be moved by doubled steps.
 
-	// Uniform
-	namespace rnd
+		For example, the legacy single-thread simulation can be
+	processed by several threads with identical random numbers
+	of each frame:
+
+@code
+	// the frame uses FRAME_SIZE random numbers
+	void worker(size_t w, size_t N_workers, const Random &gen)
 	{
+		Random g(gen);
+		g.jump(w*FRAME_SIZE);
+
+		for (size_t k = w; k < N_frames; k += N_workers)
+		{
+			frame(k, g);
+			g.jump((N_workers-1)*FRAME_SIZE);
+		}
+	}
+@endcode
 
-//////////////////////////////////////////////////////////////////////////
-/// @brief The default constructor.
-/**
-		The default constructor uses the seed value
-	from the global Random generator.
+@param steps The number of steps.
 */
-Uniform::Uniform()
-	: inherited(g_seed())
-{}
+void Random::jump(size_t steps)
+{
+	// near jump
+	advance(steps & ((size_t(1)<<MT_NEAR_LOG2) - 1));
+	steps >>= MT_NEAR_LOG2;
+
+	// far jumps
+	for (size_t k = MT_NEAR_LOG2; steps; ++k, steps >>= 1)
+		if (steps&1)
+			jump_pow2(k);
+}
 
 
 //////////////////////////////////////////////////////////////////////////
-/// @brief The main constructor.
+/// @brief Jump ahead by power of two.
 /**
-		This constructor initializes the generator by @a seed value.
+		This method moves the generator forward by 2^@a log2_steps random
+	numbers. The @a log2_steps can be greater than the bit width of
+	size_t type. The jump polynomials are calculated once and cached,
+	so the first jump by a new power of two takes more time.
 
-@param seed The seed value.
+@param log2_steps The binary logarithm of number of steps.
 */
-Uniform::Uniform(seed_type seed)
-	: inherited(seed)
-{}
+void Random::jump_pow2(size_t log2_steps)
+{
+	if (log2_steps < MT_NEAR_LOG2)
+	{
+		advance(size_t(1) << log2_steps);
+		return;
+	}
+
+	// 2^k mod period of high bits
+	size_t steps_mod = 1;
+	for (size_t i = 0; i < log2_steps; ++i)
+		steps_mod = (2*steps_mod) % MT_HI_PERIOD;
+
+	jump(mt_jump_poly(log2_steps), steps_mod, true);
+}
 
 
 //////////////////////////////////////////////////////////////////////////
-/// @brief Generate the random value in specified range.
+/// @brief Split the sequence.
 /**
-		This method generates the random number in range [@a lo, @a up].
+		This method creates @a N_streams generators. The first generator is
+	a copy of this generator, each next generator is moved forward by
+	2^@a log2_stride random numbers relative to the previous one.
+	So all generators produce non-overlapping subsequences of
+	the 2^@a log2_stride length.
+
+@param N_streams The number of generators.
+@param log2_stride The binary logarithm of subsequence length.
+@return The generators.
+*/
+std::vector<Random> Random::split(size_t N_streams, size_t log2_stride) const
+{
+	std::vector<Random> res;
+	res.reserve(N_streams);
+
+	for (size_t i = 0; i < N_streams; ++i)
+	{
+		if (i)
+		{
+			res.push_back(res.back());
+			res.back().jump_pow2(log2_stride);
+		}
+		else
+			res.push_back(*this);
+	}
+
+	return res;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// move forward step by step
+void Random::advance(size_t steps)
+{
+	while (steps)
+	{
+		if (N <= m_curr)
+			reload();
+
+		const size_t n = (steps < N-m_curr)
+			? steps : N-m_curr;
+
+		m_curr += n;
+		steps -= n;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// move forward by jump polynomial
+/*
+		The state words are the MT sequence x[0], ..., x[N-1] and the next
+	random number is x[m_curr]. This method calculates x[K], ..., x[K+N-1]
+	as sum of the shifted sequences x[i], ..., x[i+N-1], where
+	poly[i] is non-zero (poly = t^K mod phi). The m_curr is kept.
+
+		Since the x[0] is used by recurrence only partially,
+	the low bits of x[K] are restored from x[K+N-1] and x[K+M-1].
+
+		For 64-bit value_type the high 32 bits of state words are also
+	moved by recurrence: hi(x[i+N]) = hi(x[i+M]). So the high bits
+	are periodic with (N-M) period.
+*/
+void Random::jump(const std::vector<unsigned int> &poly, size_t steps_mod, bool steps_big)
+{
+	const value_type LO_MASK = 0xFFFFFFFFUL;
+
+	// the low 32 bits
+	std::vector<unsigned int> seq(MT_MEXP + N);
+	for (size_t i = 0; i < N; ++i)
+		seq[i] = (unsigned int)(m_rand[i]&LO_MASK);
+	mt_sequence(seq);
+
+	std::vector<unsigned int> res(N, 0);
+	for (size_t i = 0; i < MT_MEXP; ++i)
+		if (bit(poly, i))
+	{
+		const unsigned int *x = &seq[i];
+		for (size_t j = 0; j < N; ++j)
+			res[j] ^= x[j];
+	}
+
+	{ // restore low bits of x[K]
+		const unsigned int t = res[N-1] ^ res[MT_M-1];
+		const unsigned int y = ((t&0x80000000U)
+			? ((t ^ 0x9908B0DFU) << 1) | 1U
+			: (t << 1));
+
+		res[0] = (res[0]&0x80000000U) | (y&0x7FFFFFFFU);
+	}
+
+	// the high bits (zero for 32-bit value_type)
+	std::vector<value_type> hi(N);
+	for (size_t i = 0; i < N; ++i)
+		hi[i] = m_rand[i] & ~LO_MASK;
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		value_type h;
+		if (!steps_big && steps_mod+i < N)
+			h = hi[steps_mod+i];
+		else
+			h = hi[MT_M + (steps_mod + i + MT_HI_PERIOD
+				- MT_M%MT_HI_PERIOD) % MT_HI_PERIOD];
+
+		m_rand[i] = h | res[i];
+	}
+}
+
+	} // Random
+
+
+	// Philox
+	namespace rnd
+	{
+		namespace
+		{
+
+// Philox4x32 constants
+const unsigned int PHILOX_M0 = 0xD2511F53U;
+const unsigned int PHILOX_M1 = 0xCD9E8D57U;
+const unsigned int PHILOX_W0 = 0x9E3779B9U;
+const unsigned int PHILOX_W1 = 0xBB67AE85U;
+
+// number of rounds
+enum { PHILOX_ROUNDS = 10 };
+
+
+//////////////////////////////////////////////////////////////////////////
+// low 32 bits (safe for 32-bit types)
+inline unsigned int lo32(size_t x)
+{
+	return (unsigned int)(x & 0xFFFFFFFFUL);
+}
+
+// high 32 bits (safe for 32-bit types)
+inline unsigned int hi32(size_t x)
+{
+	return (unsigned int)(((x >> 16) >> 16) & 0xFFFFFFFFUL);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// generate blocks (general version)
+void philox_T(const unsigned int key[2], const unsigned int ctr[4],
+	size_t N_blocks, unsigned int *out)
+{
+	unsigned int c0 = ctr[0];
+	unsigned int c1 = ctr[1];
+
+	for (size_t b = 0; b < N_blocks; ++b)
+	{
+		unsigned int x0 = c0, x1 = c1;
+		unsigned int x2 = ctr[2], x3 = ctr[3];
+		unsigned int k0 = key[0], k1 = key[1];
+
+		for (size_t r = 0; r < PHILOX_ROUNDS; ++r)
+		{
+			const UInt64 p0 = UInt64(PHILOX_M0) * x0;
+			const UInt64 p1 = UInt64(PHILOX_M1) * x2;
+
+			const unsigned int hi0 = (unsigned int)(p0 >> 32);
+			const unsigned int lo0 = (unsigned int)(p0);
+			const unsigned int hi1 = (unsigned int)(p1 >> 32);
+			const unsigned int lo1 = (unsigned int)(p1);
+
+			x0 = hi1 ^ x1 ^ k0;
+			x1 = lo1;
+			x2 = hi0 ^ x3 ^ k1;
+			x3 = lo0;
+
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+
+		out[0] = x0; out[1] = x1;
+		out[2] = x2; out[3] = x3;
+		out += 4;
+
+		// next counter
+		if (0 == ++c0)
+			++c1;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// 4 x (32 bit * 32 bit) => 4 x 64 bit products
+inline void philox_mulhilo_SSE2(__m128i a, __m128i m, __m128i &lo, __m128i &hi)
+{
+	const __m128i p02 = _mm_mul_epu32(a, m);
+	const __m128i p13 = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+
+	lo = _mm_unpacklo_epi32(
+		_mm_shuffle_epi32(p02, _MM_SHUFFLE(0,0,2,0)),
+		_mm_shuffle_epi32(p13, _MM_SHUFFLE(0,0,2,0)));
+	hi = _mm_unpacklo_epi32(
+		_mm_shuffle_epi32(p02, _MM_SHUFFLE(0,0,3,1)),
+		_mm_shuffle_epi32(p13, _MM_SHUFFLE(0,0,3,1)));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// generate blocks (SSE2 version, four blocks at once)
+void philox_SSE2(const unsigned int key[2], const unsigned int ctr[4],
+	size_t N_blocks, unsigned int *out)
+{
+	const __m128i M0 = _mm_set1_epi32(int(PHILOX_M0));
+	const __m128i M1 = _mm_set1_epi32(int(PHILOX_M1));
+
+	unsigned int c0 = ctr[0];
+	unsigned int c1 = ctr[1];
+
+	// quartets of blocks
+	for (size_t b = 0; b < N_blocks/4; ++b)
+	{
+		unsigned int lc0[4], lc1[4];
+		for (size_t i = 0; i < 4; ++i)
+		{
+			lc0[i] = c0;
+			lc1[i] = c1;
+
+			// next counter
+			if (0 == ++c0)
+				++c1;
+		}
+
+		// one block per lane
+		__m128i x0 = _mm_loadu_si128((const __m128i*)lc0);
+		__m128i x1 = _mm_loadu_si128((const __m128i*)lc1);
+		__m128i x2 = _mm_set1_epi32(int(ctr[2]));
+		__m128i x3 = _mm_set1_epi32(int(ctr[3]));
+		unsigned int k0 = key[0], k1 = key[1];
+
+		for (size_t r = 0; r < PHILOX_ROUNDS; ++r)
+		{
+			__m128i lo0, hi0, lo1, hi1;
+			philox_mulhilo_SSE2(x0, M0, lo0, hi0);
+			philox_mulhilo_SSE2(x2, M1, lo1, hi1);
+
+			x0 = _mm_xor_si128(_mm_xor_si128(hi1, x1), _mm_set1_epi32(int(k0)));
+			x1 = lo1;
+			x2 = _mm_xor_si128(_mm_xor_si128(hi0, x3), _mm_set1_epi32(int(k1)));
+			x3 = lo0;
+
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+
+		// transpose: lanes => blocks
+		const __m128i t0 = _mm_unpacklo_epi32(x0, x1); // a0 b0 a1 b1
+		const __m128i t1 = _mm_unpacklo_epi32(x2, x3); // c0 d0 c1 d1
+		const __m128i t2 = _mm_unpackhi_epi32(x0, x1); // a2 b2 a3 b3
+		const __m128i t3 = _mm_unpackhi_epi32(x2, x3); // c2 d2 c3 d3
+
+		_mm_storeu_si128((__m128i*)(out+ 0), _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128((__m128i*)(out+ 4), _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128((__m128i*)(out+ 8), _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128((__m128i*)(out+12), _mm_unpackhi_epi64(t2, t3));
+		out += 16;
+	}
+
+	// remain
+	if (N_blocks%4)
+	{
+		const unsigned int rctr[4] = { c0, c1, ctr[2], ctr[3] };
+		philox_T(key, rctr, N_blocks%4, out);
+	}
+}
+
+		} // local
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The default constructor.
+/**
+		The default constructor initializes the PRS by zero
+	seed value, zero stream and zero counter.
+*/
+Philox::Philox()
+	: m_curr(N), m_seed(0),
+	  m_stream(0), m_next(0)
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The main constructor.
+/**
+		The constructor initializes the PRS by @a seed value.
+	The first random number is the first number of
+	the @a counter block of the @a stream.
+
+@param seed The seed value of the PRS.
+@param stream The stream index.
+@param counter The block counter.
+*/
+Philox::Philox(seed_type seed, size_type stream, size_type counter)
+	: m_curr(N), m_seed(seed),
+	  m_stream(stream), m_next(counter)
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The maximum random value.
+/**
+		This static method returns the maximum possible random value.
+
+@return The maximum possible random value.
+*/
+Philox::value_type Philox::rand_max()
+{
+	return 0xFFFFFFFFUL;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number in specified range.
+/**
+		This method generates the random number in range [@a lo, @a up).
+
+	The @a lo argument must be less than the @a up argument!
+
+@param lo Lower bound (inclusive)
+@param up Upper bound (exclusive)
+@return The random number.
+*/
+Philox::value_type Philox::operator()(value_type lo, value_type up)
+{
+	assert(lo < up && "lower bound must be less than upper bound");
+	return lo + (*this)(up - lo);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number.
+/**
+		This method generates the random number in range [0, @a up).
+
+@param up Upper bound (exclusive). Can't be zero.
+@return The random number.
+*/
+Philox::value_type Philox::operator()(value_type up)
+{
+	assert(0!=up && "upper bound can't be zero");
+
+	return (*this)() % up;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number.
+/**
+		This method generates the random number in range [0, rand_max()].
+
+@return The random number.
+*/
+Philox::value_type Philox::operator()()
+{
+	if (N <= m_curr)
+		reload();
+
+	return m_rand[m_curr++];
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Set the block counter.
+/**
+		This method moves the generator to the begin of
+	the @a counter block. It takes constant time.
+
+@param counter The block counter.
+*/
+void Philox::seek(size_type counter)
+{
+	m_next = counter;
+	m_curr = N;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the block counter.
+/**
+		This method returns the counter of block
+	which contains the next random number.
+
+@return The block counter.
+*/
+Philox::size_type Philox::counter() const
+{
+	return m_next - (N - m_curr + 3)/4;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the stream index.
+/**
+@return The stream index.
+*/
+Philox::size_type Philox::stream() const
+{
+	return m_stream;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the seed value.
+/**
+@return The seed value.
+*/
+Philox::seed_type Philox::seed() const
+{
+	return m_seed;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate several blocks.
+/**
+		This static method generates @a N_blocks blocks of the (@a seed,
+	@a stream) sequence starting from the @a counter block. Each block
+	contains four 32-bit random numbers, so the output buffer @a out
+	should have at least 4*@a N_blocks elements.
+
+		The SSE2 instructions are used if supported.
+
+@param seed The seed value.
+@param stream The stream index.
+@param counter The first block counter.
+@param N_blocks The number of blocks.
+@param[out] out The output buffer.
+*/
+void Philox::generate(seed_type seed, size_type stream,
+	size_type counter, size_type N_blocks, unsigned int *out)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(const unsigned int*, const unsigned int*, size_t, unsigned int*);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::SSE2)
+				return &philox_SSE2;
+
+			return &philox_T;
+		}
+	};
+
+	static Aux::FuncPtr run = Aux::select();
+
+	const unsigned int key[2] = { lo32(seed), hi32(seed) };
+	const unsigned int ctr[4] = { lo32(counter), hi32(counter),
+		lo32(stream), hi32(stream) };
+
+	run(key, ctr, N_blocks, out);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// generate N words at one time
+void Philox::reload()
+{
+	generate(m_seed, m_stream,
+		m_next, N_BLOCKS, m_rand);
+
+	m_next += N_BLOCKS;
+	m_curr = 0;
+}
+
+	} // Philox
+
+
+	// Xoshiro
+	namespace rnd
+	{
+		namespace
+		{
+
+// 64-bit constant from two halves (no 64-bit literals)
+inline RandomBits make64(unsigned int hi, unsigned int lo)
+{
+	return (RandomBits(hi) << 32) | RandomBits(lo);
+}
+
+// rotate left
+inline RandomBits rotl(RandomBits x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+// SplitMix64 generator (used for seeding)
+inline RandomBits splitmix64(RandomBits &x)
+{
+	x += make64(0x9E3779B9U, 0x7F4A7C15U);
+
+	RandomBits z = x;
+	z = (z ^ (z >> 30)) * make64(0xBF58476DU, 0x1CE4E5B9U);
+	z = (z ^ (z >> 27)) * make64(0x94D049BBU, 0x133111EBU);
+	return z ^ (z >> 31);
+}
+
+		} // local
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The default constructor.
+/**
+		The default constructor initializes the PRS by zero seed value.
+*/
+Xoshiro::Xoshiro()
+{
+	srand(0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The main constructor.
+/**
+		The constructor initializes the PRS by @a seed value.
+
+@param seed The seed value.
+*/
+Xoshiro::Xoshiro(seed_type seed)
+{
+	srand(seed);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The maximum random value.
+/**
+		This static method returns the maximum possible random value.
+
+@return The maximum possible random value.
+*/
+Xoshiro::value_type Xoshiro::rand_max()
+{
+	return 0xFFFFFFFFUL;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number in specified range.
+/**
+		This method generates the random number in range [@a lo, @a up).
+
+	The @a lo argument must be less than the @a up argument!
+
+@param lo Lower bound (inclusive)
+@param up Upper bound (exclusive)
+@return The random number.
+*/
+Xoshiro::value_type Xoshiro::operator()(value_type lo, value_type up)
+{
+	assert(lo < up && "lower bound must be less than upper bound");
+	return lo + (*this)(up - lo);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number.
+/**
+		This method generates the random number in range [0, @a up).
+
+@param up Upper bound (exclusive). Can't be zero.
+@return The random number.
+*/
+Xoshiro::value_type Xoshiro::operator()(value_type up)
+{
+	assert(0!=up && "upper bound can't be zero");
+
+	return (*this)() % up;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number.
+/**
+		This method generates the random number in range [0, rand_max()].
+	The low half of each 64-bit output is returned first.
+
+@return The random number.
+*/
+Xoshiro::value_type Xoshiro::operator()()
+{
+	if (m_half_ready)
+	{
+		m_half_ready = false;
+		return value_type(m_half >> 32);
+	}
+
+	m_half = next();
+	m_half_ready = true;
+	return value_type(m_half & 0xFFFFFFFFUL);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the 64-bit random number.
+/**
+		This method returns the next 64-bit output of the generator.
+	The unused half of the previous output (if any) is skipped.
+
+@return The 64-bit random number.
+*/
+Xoshiro::word_type Xoshiro::next()
+{
+	const word_type res = rotl(m_s[1] * 5, 7) * 9;
+	const word_type t = m_s[1] << 17;
+
+	m_s[2] ^= m_s[0];
+	m_s[3] ^= m_s[1];
+	m_s[1] ^= m_s[2];
+	m_s[0] ^= m_s[3];
+
+	m_s[2] ^= t;
+	m_s[3] = rotl(m_s[3], 45);
+
+	m_half_ready = false;
+	return res;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Jump ahead.
+/**
+		This method is equivalent to the 2^128 calls of next().
+	It can be used to generate 2^128 non-overlapping streams.
+*/
+void Xoshiro::jump()
+{
+	const word_type JUMP[4] = {
+		make64(0x180EC6D3U, 0x3CFD0ABAU),
+		make64(0xD5A61266U, 0xF0C9392CU),
+		make64(0xA9582618U, 0xE03FC9AAU),
+		make64(0x39ABDC45U, 0x29B1661CU) };
+
+	jump(JUMP);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Long jump ahead.
+/**
+		This method is equivalent to the 2^192 calls of next().
+	It can be used to generate 2^64 starting points,
+	from each of which jump() will generate 2^64
+	non-overlapping streams.
+*/
+void Xoshiro::long_jump()
+{
+	const word_type LONG_JUMP[4] = {
+		make64(0x76E15D3EU, 0xFEFDCBBFU),
+		make64(0xC5004E44U, 0x1C522FB3U),
+		make64(0x77710069U, 0x854EE241U),
+		make64(0x39109BB0U, 0x2ACBE635U) };
+
+	jump(LONG_JUMP);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Set seed value.
+/**
+		This method initializes the PRS by @a seed value.
+
+@param seed The seed value of the PRS.
+*/
+void Xoshiro::srand(seed_type seed)
+{
+	word_type x = word_type(seed);
+	for (size_t i = 0; i < 4; ++i)
+		m_s[i] = splitmix64(x);
+
+	m_half = 0;
+	m_half_ready = false;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// move forward by jump polynomial
+void Xoshiro::jump(const word_type poly[4])
+{
+	word_type s[4] = { 0, 0, 0, 0 };
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		for (size_t b = 0; b < 64; ++b)
+		{
+			if (poly[i] & (word_type(1) << b))
+			{
+				s[0] ^= m_s[0];
+				s[1] ^= m_s[1];
+				s[2] ^= m_s[2];
+				s[3] ^= m_s[3];
+			}
+
+			next();
+		}
+	}
+
+	for (size_t i = 0; i < 4; ++i)
+		m_s[i] = s[i];
+}
+
+	} // Xoshiro
+
+
+	// Sobol
+	namespace rnd
+	{
+		namespace
+		{
+
+// maximum degree of the primitive polynomials
+enum { SOBOL_MAX_DEGREE = 11 };
+
+// the primitive polynomial and initial direction numbers
+struct SobolInit
+{
+	unsigned short poly; // bit i is coefficient of x^i
+	unsigned short m[SOBOL_MAX_DEGREE];
+};
+
+// the new-joe-kuo-6.21201 table (dimensions 2..MAX_DIM)
+const SobolInit SOBOL_INIT[Sobol::MAX_DIM-1] = {
+	{ 3, { 1 } },
+	{ 7, { 1, 3 } },
+	{ 11, { 1, 3, 1 } },
+	{ 13, { 1, 1, 1 } },
+	{ 19, { 1, 1, 3, 3 } },
+	{ 25, { 1, 3, 5, 13 } },
+	{ 37, { 1, 1, 5, 5, 17 } },
+	{ 41, { 1, 1, 5, 5, 5 } },
+	{ 47, { 1, 1, 7, 11, 19 } },
+	{ 55, { 1, 1, 5, 1, 1 } },
+	{ 59, { 1, 1, 1, 3, 11 } },
+	{ 61, { 1, 3, 5, 5, 31 } },
+	{ 67, { 1, 3, 3, 9, 7, 49 } },
+	{ 91, { 1, 1, 1, 15, 21, 21 } },
+	{ 97, { 1, 3, 1, 13, 27, 49 } },
+	{ 103, { 1, 1, 1, 15, 7, 5 } },
+	{ 109, { 1, 3, 1, 15, 13, 25 } },
+	{ 115, { 1, 1, 5, 5, 19, 61 } },
+	{ 131, { 1, 3, 7, 11, 23, 15, 103 } },
+	{ 137, { 1, 3, 7, 13, 13, 15, 69 } },
+	{ 143, { 1, 1, 3, 13, 7, 35, 63 } },
+	{ 145, { 1, 3, 5, 9, 1, 25, 53 } },
+	{ 157, { 1, 3, 1, 13, 9, 35, 107 } },
+	{ 167, { 1, 3, 1, 5, 27, 61, 31 } },
+	{ 171, { 1, 1, 5, 11, 19, 41, 61 } },
+	{ 185, { 1, 3, 5, 3, 3, 13, 69 } },
+	{ 191, { 1, 1, 7, 13, 1, 19, 1 } },
+	{ 193, { 1, 3, 7, 5, 13, 19, 59 } },
+	{ 203, { 1, 1, 3, 9, 25, 29, 41 } },
+	{ 211, { 1, 3, 5, 13, 23, 1, 55 } },
+	{ 213, { 1, 3, 7, 3, 13, 59, 17 } },
+	{ 229, { 1, 3, 1, 3, 5, 53, 69 } },
+	{ 239, { 1, 1, 5, 5, 23, 33, 13 } },
+	{ 241, { 1, 1, 7, 7, 1, 61, 123 } },
+	{ 247, { 1, 1, 7, 9, 13, 61, 49 } },
+	{ 253, { 1, 3, 3, 5, 3, 55, 33 } },
+	{ 285, { 1, 3, 1, 15, 31, 13, 49, 245 } },
+	{ 299, { 1, 3, 5, 15, 31, 59, 63, 97 } },
+	{ 301, { 1, 3, 1, 11, 11, 11, 77, 249 } },
+	{ 333, { 1, 3, 1, 11, 27, 43, 71, 9 } },
+	{ 351, { 1, 1, 7, 15, 21, 11, 81, 45 } },
+	{ 355, { 1, 3, 7, 3, 25, 31, 65, 79 } },
+	{ 357, { 1, 3, 1, 1, 19, 11, 3, 205 } },
+	{ 361, { 1, 1, 5, 9, 19, 21, 29, 157 } },
+	{ 369, { 1, 3, 7, 11, 1, 33, 89, 185 } },
+	{ 391, { 1, 3, 3, 3, 15, 9, 79, 71 } },
+	{ 397, { 1, 3, 7, 11, 15, 39, 119, 27 } },
+	{ 425, { 1, 1, 3, 1, 11, 31, 97, 225 } },
+	{ 451, { 1, 1, 1, 3, 23, 43, 57, 177 } },
+	{ 463, { 1, 3, 7, 7, 17, 17, 37, 71 } },
+	{ 487, { 1, 3, 1, 5, 27, 63, 123, 213 } },
+	{ 501, { 1, 1, 3, 5, 11, 43, 53, 133 } },
+	{ 529, { 1, 3, 5, 5, 29, 17, 47, 173, 479 } },
+	{ 539, { 1, 3, 3, 11, 3, 1, 109, 9, 69 } },
+	{ 545, { 1, 1, 1, 5, 17, 39, 23, 5, 343 } },
+	{ 557, { 1, 3, 1, 5, 25, 15, 31, 103, 499 } },
+	{ 563, { 1, 1, 1, 11, 11, 17, 63, 105, 183 } },
+	{ 601, { 1, 1, 5, 11, 9, 29, 97, 231, 363 } },
+	{ 607, { 1, 1, 5, 15, 19, 45, 41, 7, 383 } },
+	{ 617, { 1, 3, 7, 7, 31, 19, 83, 137, 221 } },
+	{ 623, { 1, 1, 1, 3, 23, 15, 111, 223, 83 } },
+	{ 631, { 1, 1, 5, 13, 31, 15, 55, 25, 161 } },
+	{ 637, { 1, 1, 3, 13, 25, 47, 39, 87, 257 } },
+	{ 647, { 1, 1, 1, 11, 21, 53, 125, 249, 293 } },
+	{ 661, { 1, 1, 7, 11, 11, 7, 57, 79, 323 } },
+	{ 675, { 1, 1, 5, 5, 17, 13, 81, 3, 131 } },
+	{ 677, { 1, 1, 7, 13, 23, 7, 65, 251, 475 } },
+	{ 687, { 1, 3, 5, 1, 9, 43, 3, 149, 11 } },
+	{ 695, { 1, 1, 3, 13, 31, 13, 13, 255, 487 } },
+	{ 701, { 1, 3, 3, 1, 5, 63, 89, 91, 127 } },
+	{ 719, { 1, 1, 3, 3, 1, 19, 123, 127, 237 } },
+	{ 721, { 1, 1, 5, 7, 23, 31, 37, 243, 289 } },
+	{ 731, { 1, 1, 5, 11, 17, 53, 117, 183, 491 } },
+	{ 757, { 1, 1, 1, 5, 1, 13, 13, 209, 345 } },
+	{ 761, { 1, 1, 3, 15, 1, 57, 115, 7, 33 } },
+	{ 787, { 1, 3, 1, 11, 7, 43, 81, 207, 175 } },
+	{ 789, { 1, 3, 1, 1, 15, 27, 63, 255, 49 } },
+	{ 799, { 1, 3, 5, 3, 27, 61, 105, 171, 305 } },
+	{ 803, { 1, 1, 5, 3, 1, 3, 57, 249, 149 } },
+	{ 817, { 1, 1, 3, 5, 5, 57, 15, 13, 159 } },
+	{ 827, { 1, 1, 1, 11, 7, 11, 105, 141, 225 } },
+	{ 847, { 1, 3, 3, 5, 27, 59, 121, 101, 271 } },
+	{ 859, { 1, 3, 5, 9, 11, 49, 51, 59, 115 } },
+	{ 865, { 1, 1, 7, 1, 23, 45, 125, 71, 419 } },
+	{ 875, { 1, 1, 3, 5, 23, 5, 105, 109, 75 } },
+	{ 877, { 1, 1, 7, 15, 7, 11, 67, 121, 453 } },
+	{ 883, { 1, 3, 7, 3, 9, 13, 31, 27, 449 } },
+	{ 895, { 1, 3, 1, 15, 19, 39, 39, 89, 15 } },
+	{ 901, { 1, 1, 1, 1, 1, 33, 73, 145, 379 } },
+	{ 911, { 1, 3, 1, 15, 15, 43, 29, 13, 483 } },
+	{ 949, { 1, 1, 7, 3, 19, 27, 85, 131, 431 } },
+	{ 953, { 1, 3, 3, 3, 5, 35, 23, 195, 349 } },
+	{ 967, { 1, 3, 3, 7, 9, 27, 39, 59, 297 } },
+	{ 971, { 1, 1, 3, 9, 11, 17, 13, 241, 157 } },
+	{ 973, { 1, 3, 7, 15, 25, 57, 33, 189, 213 } },
+	{ 981, { 1, 1, 7, 1, 9, 55, 73, 83, 217 } },
+	{ 985, { 1, 3, 3, 13, 19, 27, 23, 113, 249 } },
+	{ 995, { 1, 3, 5, 3, 23, 43, 3, 253, 479 } },
+	{ 1001, { 1, 1, 5, 5, 11, 5, 45, 117, 217 } },
+	{ 1019, { 1, 3, 3, 7, 29, 37, 33, 123, 147 } },
+	{ 1033, { 1, 3, 1, 15, 5, 5, 37, 227, 223, 459 } },
+	{ 1051, { 1, 1, 7, 5, 5, 39, 63, 255, 135, 487 } },
+	{ 1063, { 1, 3, 1, 7, 9, 7, 87, 249, 217, 599 } },
+	{ 1069, { 1, 1, 3, 13, 9, 47, 7, 225, 363, 247 } },
+	{ 1125, { 1, 3, 7, 13, 19, 13, 9, 67, 9, 737 } },
+	{ 1135, { 1, 3, 5, 5, 19, 59, 7, 41, 319, 677 } },
+	{ 1153, { 1, 1, 5, 3, 31, 63, 15, 43, 207, 789 } },
+	{ 1163, { 1, 1, 7, 9, 13, 39, 3, 47, 497, 169 } },
+	{ 1221, { 1, 3, 1, 7, 21, 17, 97, 19, 415, 905 } },
+	{ 1239, { 1, 3, 7, 1, 3, 31, 71, 111, 165, 127 } },
+	{ 1255, { 1, 1, 5, 11, 1, 61, 83, 119, 203, 847 } },
+	{ 1267, { 1, 3, 3, 13, 9, 61, 19, 97, 47, 35 } },
+	{ 1279, { 1, 1, 7, 7, 15, 29, 63, 95, 417, 469 } },
+	{ 1293, { 1, 3, 1, 9, 25, 9, 71, 57, 213, 385 } },
+	{ 1305, { 1, 3, 5, 13, 31, 47, 101, 57, 39, 341 } },
+	{ 1315, { 1, 1, 3, 3, 31, 57, 125, 173, 365, 551 } },
+	{ 1329, { 1, 3, 7, 1, 13, 57, 67, 157, 451, 707 } },
+	{ 1341, { 1, 1, 1, 7, 21, 13, 105, 89, 429, 965 } },
+	{ 1347, { 1, 1, 5, 9, 17, 51, 45, 119, 157, 141 } },
+	{ 1367, { 1, 3, 7, 7, 13, 45, 91, 9, 129, 741 } },
+	{ 1387, { 1, 3, 7, 1, 23, 57, 67, 141, 151, 571 } },
+	{ 1413, { 1, 1, 3, 11, 17, 47, 93, 107, 375, 157 } },
+	{ 1423, { 1, 3, 3, 5, 11, 21, 43, 51, 169, 915 } },
+	{ 1431, { 1, 1, 5, 3, 15, 55, 101, 67, 455, 625 } },
+	{ 1441, { 1, 3, 5, 9, 1, 23, 29, 47, 345, 595 } },
+	{ 1479, { 1, 3, 7, 7, 5, 49, 29, 155, 323, 589 } },
+	{ 1509, { 1, 3, 3, 7, 5, 41, 127, 61, 261, 717 } },
+	{ 1527, { 1, 3, 7, 7, 17, 23, 117, 67, 129, 1009 } },
+	{ 1531, { 1, 1, 3, 13, 11, 39, 21, 207, 123, 305 } },
+	{ 1555, { 1, 1, 3, 9, 29, 3, 95, 47, 231, 73 } },
+	{ 1557, { 1, 3, 1, 9, 1, 29, 117, 21, 441, 259 } },
+	{ 1573, { 1, 3, 1, 13, 21, 39, 125, 211, 439, 723 } },
+	{ 1591, { 1, 1, 7, 3, 17, 63, 115, 89, 49, 773 } },
+	{ 1603, { 1, 3, 7, 13, 11, 33, 101, 107, 63, 73 } },
+	{ 1615, { 1, 1, 5, 5, 13, 57, 63, 135, 437, 177 } },
+	{ 1627, { 1, 1, 3, 7, 27, 63, 93, 47, 417, 483 } },
+	{ 1657, { 1, 1, 3, 1, 23, 29, 1, 191, 49, 23 } },
+	{ 1663, { 1, 1, 3, 15, 25, 55, 9, 101, 219, 607 } },
+	{ 1673, { 1, 3, 1, 7, 7, 19, 51, 251, 393, 307 } },
+	{ 1717, { 1, 3, 3, 3, 25, 55, 17, 75, 337, 3 } },
+	{ 1729, { 1, 1, 1, 13, 25, 17, 65, 45, 479, 413 } },
+	{ 1747, { 1, 1, 7, 7, 27, 49, 99, 161, 213, 727 } },
+	{ 1759, { 1, 3, 5, 1, 23, 5, 43, 41, 251, 857 } },
+	{ 1789, { 1, 3, 3, 7, 11, 61, 39, 87, 383, 835 } },
+	{ 1815, { 1, 1, 3, 15, 13, 7, 29, 7, 505, 923 } },
+	{ 1821, { 1, 3, 7, 1, 5, 31, 47, 157, 445, 501 } },
+	{ 1825, { 1, 1, 3, 7, 1, 43, 9, 147, 115, 605 } },
+	{ 1849, { 1, 3, 3, 13, 5, 1, 119, 211, 455, 1001 } },
+	{ 1863, { 1, 1, 3, 5, 13, 19, 3, 243, 75, 843 } },
+	{ 1869, { 1, 3, 7, 7, 1, 19, 91, 249, 357, 589 } },
+	{ 1877, { 1, 1, 1, 9, 1, 25, 109, 197, 279, 411 } },
+	{ 1881, { 1, 3, 1, 15, 23, 57, 59, 135, 191, 75 } },
+	{ 1891, { 1, 1, 5, 15, 29, 21, 39, 253, 383, 349 } },
+	{ 1917, { 1, 3, 3, 5, 19, 45, 61, 151, 199, 981 } },
+	{ 1933, { 1, 3, 5, 13, 9, 61, 107, 141, 141, 1 } },
+	{ 1939, { 1, 3, 1, 11, 27, 25, 85, 105, 309, 979 } },
+	{ 1969, { 1, 3, 3, 11, 19, 7, 115, 223, 349, 43 } },
+	{ 2011, { 1, 1, 7, 9, 21, 39, 123, 21, 275, 927 } },
+	{ 2035, { 1, 1, 7, 13, 15, 41, 47, 243, 303, 437 } },
+	{ 2041, { 1, 1, 1, 7, 7, 3, 15, 99, 409, 719 } },
+	{ 2053, { 1, 3, 3, 15, 27, 49, 113, 123, 113, 67, 469 } },
+	{ 2071, { 1, 3, 7, 11, 3, 23, 87, 169, 119, 483, 199 } },
+	{ 2091, { 1, 1, 5, 15, 7, 17, 109, 229, 179, 213, 741 } },
+	{ 2093, { 1, 1, 5, 13, 11, 17, 25, 135, 403, 557, 1433 } },
+	{ 2119, { 1, 3, 1, 1, 1, 61, 67, 215, 189, 945, 1243 } },
+	{ 2147, { 1, 1, 7, 13, 17, 33, 9, 221, 429, 217, 1679 } },
+	{ 2149, { 1, 1, 3, 11, 27, 3, 15, 93, 93, 865, 1049 } },
+	{ 2161, { 1, 3, 7, 7, 25, 41, 121, 35, 373, 379, 1547 } },
+	{ 2171, { 1, 3, 3, 9, 11, 35, 45, 205, 241, 9, 59 } },
+	{ 2189, { 1, 3, 1, 7, 3, 51, 7, 177, 53, 975, 89 } },
+	{ 2197, { 1, 1, 3, 5, 27, 1, 113, 231, 299, 759, 861 } },
+	{ 2207, { 1, 3, 3, 15, 25, 29, 5, 255, 139, 891, 2031 } },
+	{ 2217, { 1, 3, 1, 1, 13, 9, 109, 193, 419, 95, 17 } },
+	{ 2225, { 1, 1, 7, 9, 3, 7, 29, 41, 135, 839, 867 } },
+	{ 2255, { 1, 1, 7, 9, 25, 49, 123, 217, 113, 909, 215 } },
+	{ 2257, { 1, 1, 7, 3, 23, 15, 43, 133, 217, 327, 901 } },
+	{ 2273, { 1, 1, 3, 3, 13, 53, 63, 123, 477, 711, 1387 } },
+	{ 2279, { 1, 1, 3, 15, 7, 29, 75, 119, 181, 957, 247 } },
+	{ 2283, { 1, 1, 1, 11, 27, 25, 109, 151, 267, 99, 1461 } },
+	{ 2293, { 1, 3, 7, 15, 5, 5, 53, 145, 11, 725, 1501 } },
+	{ 2317, { 1, 3, 7, 1, 9, 43, 71, 229, 157, 607, 1835 } },
+	{ 2323, { 1, 3, 3, 13, 25, 1, 5, 27, 471, 349, 127 } },
+	{ 2341, { 1, 1, 1, 1, 23, 37, 9, 221, 269, 897, 1685 } },
+	{ 2345, { 1, 1, 3, 3, 31, 29, 51, 19, 311, 553, 1969 } },
+	{ 2363, { 1, 3, 7, 5, 5, 55, 17, 39, 475, 671, 1529 } },
+	{ 2365, { 1, 1, 7, 1, 1, 35, 47, 27, 437, 395, 1635 } },
+	{ 2373, { 1, 1, 7, 3, 13, 23, 43, 135, 327, 139, 389 } },
+	{ 2377, { 1, 3, 7, 3, 9, 25, 91, 25, 429, 219, 513 } },
+	{ 2385, { 1, 1, 3, 5, 13, 29, 119, 201, 277, 157, 2043 } },
+	{ 2395, { 1, 3, 5, 3, 29, 57, 13, 17, 167, 739, 1031 } },
+	{ 2419, { 1, 3, 3, 5, 29, 21, 95, 27, 255, 679, 1531 } },
+	{ 2421, { 1, 3, 7, 15, 9, 5, 21, 71, 61, 961, 1201 } },
+	{ 2431, { 1, 3, 5, 13, 15, 57, 33, 93, 459, 867, 223 } },
+	{ 2435, { 1, 1, 1, 15, 17, 43, 127, 191, 67, 177, 1073 } },
+	{ 2447, { 1, 1, 1, 15, 23, 7, 21, 199, 75, 293, 1611 } },
+	{ 2475, { 1, 3, 7, 13, 15, 39, 21, 149, 65, 741, 319 } },
+	{ 2477, { 1, 3, 7, 11, 23, 13, 101, 89, 277, 519, 711 } },
+	{ 2489, { 1, 3, 7, 15, 19, 27, 85, 203, 441, 97, 1895 } },
+	{ 2503, { 1, 3, 1, 3, 29, 25, 21, 155, 11, 191, 197 } },
+	{ 2521, { 1, 1, 7, 5, 27, 11, 81, 101, 457, 675, 1687 } },
+	{ 2533, { 1, 3, 1, 5, 25, 5, 65, 193, 41, 567, 781 } },
+	{ 2551, { 1, 3, 1, 5, 11, 15, 113, 77, 411, 695, 1111 } },
+	{ 2561, { 1, 1, 3, 9, 11, 53, 119, 171, 55, 297, 509 } },
+	{ 2567, { 1, 1, 1, 1, 11, 39, 113, 139, 165, 347, 595 } },
+	{ 2579, { 1, 3, 7, 11, 9, 17, 101, 13, 81, 325, 1733 } },
+	{ 2581, { 1, 3, 1, 1, 21, 43, 115, 9, 113, 907, 645 } },
+	{ 2601, { 1, 1, 7, 3, 9, 25, 117, 197, 159, 471, 475 } },
+	{ 2633, { 1, 3, 1, 9, 11, 21, 57, 207, 485, 613, 1661 } },
+	{ 2657, { 1, 1, 7, 7, 27, 55, 49, 223, 89, 85, 1523 } },
+	{ 2669, { 1, 1, 5, 3, 19, 41, 45, 51, 447, 299, 1355 } },
+	{ 2681, { 1, 3, 1, 13, 1, 33, 117, 143, 313, 187, 1073 } },
+	{ 2687, { 1, 1, 7, 7, 5, 11, 65, 97, 377, 377, 1501 } },
+	{ 2693, { 1, 3, 1, 1, 21, 35, 95, 65, 99, 23, 1239 } },
+	{ 2705, { 1, 1, 5, 9, 3, 37, 95, 167, 115, 425, 867 } },
+	{ 2717, { 1, 3, 3, 13, 1, 37, 27, 189, 81, 679, 773 } },
+	{ 2727, { 1, 1, 3, 11, 1, 61, 99, 233, 429, 969, 49 } },
+	{ 2731, { 1, 1, 1, 7, 25, 63, 99, 165, 245, 793, 1143 } },
+	{ 2739, { 1, 1, 5, 11, 11, 43, 55, 65, 71, 283, 273 } },
+	{ 2741, { 1, 1, 5, 5, 9, 3, 101, 251, 355, 379, 1611 } },
+	{ 2773, { 1, 1, 1, 15, 21, 63, 85, 99, 49, 749, 1335 } },
+	{ 2783, { 1, 1, 5, 13, 27, 9, 121, 43, 255, 715, 289 } },
+	{ 2793, { 1, 3, 1, 5, 27, 19, 17, 223, 77, 571, 1415 } },
+	{ 2799, { 1, 1, 5, 3, 13, 59, 125, 251, 195, 551, 1737 } },
+	{ 2801, { 1, 3, 3, 15, 13, 27, 49, 105, 389, 971, 755 } },
+	{ 2811, { 1, 3, 5, 15, 23, 43, 35, 107, 447, 763, 253 } },
+	{ 2819, { 1, 3, 5, 11, 21, 3, 17, 39, 497, 407, 611 } },
+	{ 2825, { 1, 1, 7, 13, 15, 31, 113, 17, 23, 507, 1995 } },
+	{ 2833, { 1, 1, 7, 15, 3, 15, 31, 153, 423, 79, 503 } },
+	{ 2867, { 1, 1, 7, 9, 19, 25, 23, 171, 505, 923, 1989 } },
+	{ 2879, { 1, 1, 5, 9, 21, 27, 121, 223, 133, 87, 697 } },
+	{ 2881, { 1, 1, 5, 5, 9, 19, 107, 99, 319, 765, 1461 } },
+	{ 2891, { 1, 1, 3, 3, 19, 25, 3, 101, 171, 729, 187 } },
+	{ 2905, { 1, 1, 3, 1, 13, 23, 85, 93, 291, 209, 37 } },
+	{ 2911, { 1, 1, 1, 15, 25, 25, 77, 253, 333, 947, 1073 } },
+	{ 2917, { 1, 1, 3, 9, 17, 29, 55, 47, 255, 305, 2037 } },
+	{ 2927, { 1, 3, 3, 9, 29, 63, 9, 103, 489, 939, 1523 } },
+	{ 2941, { 1, 3, 7, 15, 7, 31, 89, 175, 369, 339, 595 } },
+	{ 2951, { 1, 3, 7, 13, 25, 5, 71, 207, 251, 367, 665 } },
+	{ 2955, { 1, 3, 3, 3, 21, 25, 75, 35, 31, 321, 1603 } },
+	{ 2963, { 1, 1, 1, 9, 11, 1, 65, 5, 11, 329, 535 } },
+	{ 2965, { 1, 1, 5, 3, 19, 13, 17, 43, 379, 485, 383 } },
+	{ 2991, { 1, 3, 5, 13, 13, 9, 85, 147, 489, 787, 1133 } },
+	{ 2999, { 1, 3, 1, 1, 5, 51, 37, 129, 195, 297, 1783 } },
+	{ 3005, { 1, 1, 3, 15, 19, 57, 59, 181, 455, 697, 2033 } },
+	{ 3017, { 1, 3, 7, 1, 27, 9, 65, 145, 325, 189, 201 } },
+	{ 3035, { 1, 3, 1, 15, 31, 23, 19, 5, 485, 581, 539 } },
+	{ 3037, { 1, 1, 7, 13, 11, 15, 65, 83, 185, 847, 831 } },
+	{ 3047, { 1, 3, 5, 7, 7, 55, 73, 15, 303, 511, 1905 } },
+	{ 3053, { 1, 3, 5, 9, 7, 21, 45, 15, 397, 385, 597 } },
+	{ 3083, { 1, 3, 7, 3, 23, 13, 73, 221, 511, 883, 1265 } },
+	{ 3085, { 1, 1, 3, 11, 1, 51, 73, 185, 33, 975, 1441 } },
+	{ 3097, { 1, 3, 3, 9, 19, 59, 21, 39, 339, 37, 143 } },
+	{ 3103, { 1, 1, 7, 1, 31, 33, 19, 167, 117, 635, 639 } },
+	{ 3159, { 1, 1, 1, 3, 5, 13, 59, 83, 355, 349, 1967 } },
+	{ 3169, { 1, 1, 1, 5, 19, 3, 53, 133, 97, 863, 983 } }
+};
+
+
+// parity of 32-bit word
+inline unsigned int parity(unsigned int x)
+{
+	x ^= x >> 16;
+	x ^= x >> 8;
+	x ^= x >> 4;
+	x ^= x >> 2;
+	x ^= x >> 1;
+	return x & 1;
+}
+
+
+// inverse normal distribution function (P. Acklam, relative error 1.15e-9)
+double norm_inv(double p)
+{
+	const double a[6] = { -3.969683028665376e+01, 2.209460984245205e+02,
+		-2.759285104469687e+02, 1.383577518672690e+02,
+		-3.066479806614716e+01, 2.506628277459239e+00 };
+	const double b[5] = { -5.447609879822406e+01, 1.615858368580409e+02,
+		-1.556989798598866e+02, 6.680131188771972e+01,
+		-1.328068155288572e+01 };
+	const double c[6] = { -7.784894002430293e-03, -3.223964580411365e-01,
+		-2.400758277161838e+00, -2.549732539343734e+00,
+		4.374664141464968e+00, 2.938163982698783e+00 };
+	const double d[4] = { 7.784695709041462e-03, 3.224671290700398e-01,
+		2.445134137142996e+00, 3.754408661907416e+00 };
+	const double P_LOW = 0.02425;
+
+	if (p < P_LOW) // lower tail
+	{
+		const double q = sqrt(-2.0*log(p));
+		return (((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])
+			/ ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.0);
+	}
+	else if (1.0-P_LOW < p) // upper tail
+	{
+		const double q = sqrt(-2.0*log(1.0-p));
+		return -(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])
+			/ ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.0);
+	}
+	else // central region
+	{
+		const double q = p - 0.5;
+		const double r = q*q;
+		return (((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q
+			/ (((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1.0);
+	}
+}
+
+
+// x[i] ^= v[i] (general version)
+void sobol_xor_T(size_t N, unsigned int *x, const unsigned int *v)
+{
+	for (size_t i = 0; i < N; ++i)
+		x[i] ^= v[i];
+}
+
+
+// x[i] ^= v[i] (SSE2 version, no alignment required)
+void sobol_xor_SSE2(size_t N, unsigned int *x, const unsigned int *v)
+{
+	for (; 8 <= N; N -= 8)
+	{
+		__m128i x0 = _mm_loadu_si128((const __m128i*)(x+0));
+		__m128i x1 = _mm_loadu_si128((const __m128i*)(x+4));
+		x0 = _mm_xor_si128(x0, _mm_loadu_si128((const __m128i*)(v+0)));
+		x1 = _mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)(v+4)));
+		_mm_storeu_si128((__m128i*)(x+0), x0);
+		_mm_storeu_si128((__m128i*)(x+4), x1);
+
+		x += 8;
+		v += 8;
+	}
+
+	sobol_xor_T(N, x, v);
+}
+
+
+// x[i] ^= v[i] (auto version)
+void sobol_xor(size_t N, unsigned int *x, const unsigned int *v)
+{
+	// auxiliary
+	struct Aux {
+		typedef void (*FuncPtr)(size_t, unsigned int*, const unsigned int*);
+
+		static FuncPtr select()
+		{
+			if (SIMD::Capability::SSE2)
+				return &sobol_xor_SSE2;
+
+			return &sobol_xor_T;
+		}
+	};
+
+	static Aux::FuncPtr run = Aux::select();
+
+	run(N, x, v);
+}
+
+		} // local
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The main constructor.
+/**
+		The constructor initializes the non-scrambled
+	Sobol sequence of @a dim dimensional points.
+
+@param dim The number of dimensions (1..MAX_DIM).
+*/
+Sobol::Sobol(size_type dim)
+{
+	init(dim, false, 0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The scrambled sequence constructor.
+/**
+		The constructor initializes the scrambled Sobol sequence
+	of @a dim dimensional points. The random linear matrix scrambling
+	and random digital shift are defined by the @a seed value.
+
+@param dim The number of dimensions (1..MAX_DIM).
+@param seed The scrambling seed value.
+*/
+Sobol::Sobol(size_type dim, seed_type seed)
+{
+	init(dim, true, seed);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random value in specified range.
+/**
+		This method returns the next coordinate in range [@a lo, @a up).
+
+@param lo Lower bound (inclusive)
+@param up Upper bound (exclusive)
+@return The quasi-random number.
+*/
+Sobol::value_type Sobol::operator()(value_type lo, value_type up)
+{
+	return lo + (up-lo)*(*this)();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number less than specified.
+/**
+		This method returns the next coordinate in range [0, @a up).
+
+@param up Upper bound (exclusive).
+@return The quasi-random number.
+*/
+Sobol::value_type Sobol::operator()(value_type up)
+{
+	return (*this)() * up;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random number in range [0,1).
+/**
+		This method returns the next coordinate in range [0,1).
+
+@return The quasi-random number.
+*/
+Sobol::value_type Sobol::operator()()
+{
+	return next() * (1.0/4294967296.0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the next @a N coordinates.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+*/
+void Sobol::fill(value_type *first, size_t N)
+{
+	for (size_t i = 0; i < N; ++i)
+		first[i] = next() * (1.0/4294967296.0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the normal distributed number.
+/**
+		This method transforms the next coordinate to the normal
+	distributed number with standard deviation @a stdev and zero mean.
+
+@param stdev The standard deviation.
+@return The quasi-random number.
+*/
+Sobol::value_type Sobol::normal(value_type stdev)
+{
+	return stdev * normal();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the normal distributed number.
+/**
+		This method transforms the next coordinate to the normal
+	distributed number with unit standard deviation and zero mean.
+
+	The coordinate is shifted by half of the least significant bit,
+	so the infinite values are never returned.
+
+@return The quasi-random number.
+*/
+Sobol::value_type Sobol::normal()
+{
+	return norm_inv((next() + 0.5) * (1.0/4294967296.0));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the normal distributed numbers with standard
+	deviation @a stdev and zero mean.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+@param stdev The standard deviation.
+*/
+void Sobol::fill_normal(value_type *first, size_t N, value_type stdev)
+{
+	for (size_t i = 0; i < N; ++i)
+		first[i] = stdev * norm_inv((next() + 0.5) * (1.0/4294967296.0));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the points.
+/**
+		This method generates the next @a N_points whole points.
+	The unused coordinates of the current point are skipped.
+	The output buffer @a out should have at least
+	@a N_points * dim() elements, each coordinate
+	is 32-bit fixed point number.
+
+		The SSE2 instructions are used if supported.
+
+@param N_points The number of points.
+@param[out] out The output buffer.
+*/
+void Sobol::generate(size_type N_points, unsigned int *out)
+{
+	if (!N_points)
+		return;
+
+	if (0 != m_curr)
+		next_point();
+
+	for (size_type k = 0; k < N_points; ++k)
+	{
+		if (0 != k)
+			next_point();
+
+		for (size_type d = 0; d < m_dim; ++d)
+			*out++ = m_x[d];
+	}
+
+	m_curr = m_dim;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Move to the point.
+/**
+		This method moves the generator to the begin of
+	the point with @a index. It takes constant time.
+
+		The direction numbers are 32 bits, so
+	the @a index should be less than 2^32.
+
+@param index The point index.
+*/
+void Sobol::seek(size_type index)
+{
+	assert(0 == ((index >> 16) >> 16) && "point index is out of range"); // (!) safe for 32-bit types
+
+	const size_type gray = index ^ (index >> 1);
+
+	m_x = m_shift;
+	for (size_type k = 0; k < 32; ++k)
+		if (gray & (size_type(1) << k))
+			sobol_xor(m_dim, &m_x[0], &m_dir[k*m_dim]);
+
+	m_index = index;
+	m_curr = 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Skip the points.
+/**
+		This method skips the next @a N_points whole points.
+	The unused coordinates of the current point are skipped too.
+
+@param N_points The number of points to skip.
+*/
+void Sobol::skip(size_type N_points)
+{
+	const size_type index = this->index() + N_points;
+	assert(N_points <= index && "point index is out of range");
+
+	seek(index);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the point index.
+/**
+		This method returns the index of the next whole point.
+	The current point is considered as used
+	if at least one coordinate is used.
+
+@return The point index.
+*/
+Sobol::size_type Sobol::index() const
+{
+	return (0 != m_curr) ? m_index+1 : m_index;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get the number of dimensions.
+/**
+@return The number of dimensions.
+*/
+Sobol::size_type Sobol::dim() const
+{
+	return m_dim;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// initialize direction numbers
+void Sobol::init(size_type dim, bool scramble, seed_type seed)
+{
+	assert(0 < dim && dim <= size_type(MAX_DIM)
+		&& "invalid number of dimensions");
+
+	m_dim = dim;
+	m_dir.resize(32*dim);
+	m_shift.assign(dim, 0);
+
+	Xoshiro gen(seed);
+	std::vector<unsigned int> v(32);
+
+	for (size_type d = 0; d < dim; ++d)
+	{
+		if (0 == d) // van der Corput sequence
+		{
+			for (size_type k = 0; k < 32; ++k)
+				v[k] = 1U << (31-k);
+		}
+		else
+		{
+			const SobolInit &si = SOBOL_INIT[d-1];
+
+			size_type deg = 0; // degree of polynomial
+			while (si.poly >> (deg+1))
+				++deg;
+
+			for (size_type k = 0; k < 32; ++k)
+			{
+				if (k < deg)
+				{
+					v[k] = (unsigned int)(si.m[k]) << (31-k);
+					continue;
+				}
+
+				v[k] = v[k-deg] ^ (v[k-deg] >> deg);
+				for (size_type j = 1; j < deg; ++j)
+					if ((si.poly >> (deg-j)) & 1)
+						v[k] ^= v[k-j];
+			}
+		}
+
+		if (scramble)
+		{
+			// random lower triangular matrix with unit diagonal
+			unsigned int L[32];
+			for (size_type i = 0; i < 32; ++i)
+			{
+				const unsigned int hi = i ? (0xFFFFFFFFU << (32-i)) : 0;
+				L[i] = (1U << (31-i)) | (hi & (unsigned int)(gen() & 0xFFFFFFFFUL));
+			}
+
+			for (size_type k = 0; k < 32; ++k)
+			{
+				unsigned int x = 0;
+				for (size_type i = 0; i < 32; ++i)
+					x |= parity(L[i] & v[k]) << (31-i);
+				v[k] = x;
+			}
+
+			m_shift[d] = (unsigned int)(gen() & 0xFFFFFFFFUL);
+		}
+
+		for (size_type k = 0; k < 32; ++k)
+			m_dir[k*dim + d] = v[k];
+	}
+
+	seek(0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// get the next coordinate
+unsigned int Sobol::next()
+{
+	if (m_dim <= m_curr)
+		next_point();
+
+	return m_x[m_curr++];
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// move to the next point (Gray code order)
+void Sobol::next_point()
+{
+	size_type k = 0; // the lowest zero bit of index
+	for (size_type i = m_index; i & 1; i >>= 1)
+		++k;
+
+	assert(k < 32 && "the Sobol sequence is exhausted");
+	sobol_xor(m_dim, &m_x[0], &m_dir[k*m_dim]);
+
+	m_index += 1;
+	m_curr = 0;
+}
+
+	} // Sobol
+
+
+	// Uniform
+	namespace rnd
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The default constructor.
+/**
+		The default constructor uses the seed value
+	from the global Random generator.
+*/
+template<typename G>
+UniformT<G>::UniformT()
+	: inherited(g_seed())
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The main constructor.
+/**
+		This constructor initializes the generator by @a seed value.
+
+@param seed The seed value.
+*/
+template<typename G>
+UniformT<G>::UniformT(seed_type seed)
+	: inherited(seed)
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Create from the discrete PRS generator.
+/**
+		This constructor initializes the generator by
+	the discrete PRS generator @a gen state.
+
+@param gen The discrete PRS generator.
+*/
+template<typename G>
+UniformT<G>::UniformT(const G &gen)
+	: inherited(gen)
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate the random value in specified range.
+/**
+		This method generates the random number in range [@a lo, @a up].
 
 @param lo Lower bound (inclusive)
 @param up Upper bound (inclusive)
 @return The random number.
 */
-Uniform::value_type Uniform::operator()(value_type lo, value_type hi)
+template<typename G>
+typename UniformT<G>::value_type UniformT<G>::operator()(value_type lo, value_type hi)
 {
 	// assert(lo < hi && "lower bound must be less than upper bound");
 	return lo + (hi-lo)*(*this)();
@@ -552,7 +2611,8 @@ Uniform::value_type Uniform::operator()(value_type lo, value_type hi)
 @param up Upper bound (inclusive).
 @return The random number.
 */
-Uniform::value_type Uniform::operator()(value_type up)
+template<typename G>
+typename UniformT<G>::value_type UniformT<G>::operator()(value_type up)
 {
 	return (*this)() * up;
 }
@@ -565,13 +2625,31 @@ Uniform::value_type Uniform::operator()(value_type up)
 
 @return The random number.
 */
-Uniform::value_type Uniform::operator()()
+template<typename G>
+typename UniformT<G>::value_type UniformT<G>::operator()()
 {
-	const inherited::value_type a = inherited::operator()() >> 5;
-	const inherited::value_type b = inherited::operator()() >> 6;
+	const typename G::value_type a = inherited::operator()() >> 5;
+	const typename G::value_type b = inherited::operator()() >> 6;
 	return (a*67108864.0+b) * (1.0/9007199254740991.0);
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the random numbers in range [0,1].
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+*/
+template<typename G>
+void UniformT<G>::fill(value_type *first, size_t N)
+{
+	for (size_t i = 0; i < N; ++i)
+		first[i] = (*this)();
+}
+
 	} // Uniform
 
 
@@ -585,7 +2663,8 @@ Uniform::value_type Uniform::operator()()
 		The default constructor uses the seed value
 	from the global Random generator.
 */
-Normal::Normal()
+template<typename G>
+NormalT<G>::NormalT()
 	: inherited(g_seed()),
 	  m_buf_empty(true)
 {}
@@ -598,12 +2677,28 @@ Normal::Normal()
 
 @param seed The seed value.
 */
-Normal::Normal(seed_type seed)
+template<typename G>
+NormalT<G>::NormalT(seed_type seed)
 	: inherited(seed),
 	  m_buf_empty(true)
 {}
 
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief Create from the discrete PRS generator.
+/**
+		This constructor initializes the generator by
+	the discrete PRS generator @a gen state.
+
+@param gen The discrete PRS generator.
+*/
+template<typename G>
+NormalT<G>::NormalT(const G &gen)
+	: inherited(gen),
+	  m_buf_empty(true)
+{}
+
+
 //////////////////////////////////////////////////////////////////////////
 /// @brief Generate the random value.
 /**
@@ -614,7 +2709,8 @@ Normal::Normal(seed_type seed)
 @param stdev The standard deviation.
 @return The random number.
 */
-Normal::value_type Normal::operator()(value_type mean, value_type stdev)
+template<typename G>
+typename NormalT<G>::value_type NormalT<G>::operator()(value_type mean, value_type stdev)
 {
 	return mean + stdev*(*this)();
 }
@@ -629,7 +2725,8 @@ Normal::value_type Normal::operator()(value_type mean, value_type stdev)
 @param stdev The standard deviation.
 @return The random number.
 */
-Normal::value_type Normal::operator()(value_type stdev)
+template<typename G>
+typename NormalT<G>::value_type NormalT<G>::operator()(value_type stdev)
 {
 	return stdev * (*this)();
 }
@@ -643,7 +2740,8 @@ Normal::value_type Normal::operator()(value_type stdev)
 
 @return The random number.
 */
-Normal::value_type Normal::operator()()
+template<typename G>
+typename NormalT<G>::value_type NormalT<G>::operator()()
 {
 	if (m_buf_empty)
 	{
@@ -667,6 +2765,68 @@ Normal::value_type Normal::operator()()
 	}
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the normal distributed random numbers with standard
+	deviation @a stdev and zero mean. The result is the same
+	as the sequence of @a N operator()(@a stdev) calls.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+@param stdev The standard deviation.
+*/
+template<typename G>
+void NormalT<G>::fill(value_type *first, size_t N, value_type stdev)
+{
+	size_t i = 0;
+
+	// buffered value
+	if (i < N && !m_buf_empty)
+	{
+		m_buf_empty = true;
+		first[i++] = stdev*m_buf;
+	}
+
+	// pairs
+	for (; i+1 < N; i += 2)
+	{
+		value_type x;
+
+		do { x = inherited::operator()(); }
+		while (value_type() == x);
+
+		const value_type z = stdev * sqrt(-2.0 * log(x));
+		const value_type n = inherited::operator()();
+
+		first[i+0] = z * cos(2.0*util::PI * n);
+		first[i+1] = z * sin(2.0*util::PI * n);
+	}
+
+	// remain
+	if (i < N)
+		first[i] = (*this)(stdev);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the normal distributed random numbers with unit
+	standard deviation and zero mean.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+*/
+template<typename G>
+void NormalT<G>::fill(value_type *first, size_t N)
+{
+	fill(first, N, 1.0);
+}
+
 	} // Normal
 
 
@@ -680,7 +2840,8 @@ Normal::value_type Normal::operator()()
 		The default constructor uses the seed value
 	from the global Random generator.
 */
-Exponential::Exponential()
+template<typename G>
+ExponentialT<G>::ExponentialT()
 	: inherited(g_seed())
 {}
 
@@ -692,11 +2853,26 @@ Exponential::Exponential()
 
 @param seed The seed value.
 */
-Exponential::Exponential(seed_type seed)
+template<typename G>
+ExponentialT<G>::ExponentialT(seed_type seed)
 	: inherited(seed)
 {}
 
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief Create from the discrete PRS generator.
+/**
+		This constructor initializes the generator by
+	the discrete PRS generator @a gen state.
+
+@param gen The discrete PRS generator.
+*/
+template<typename G>
+ExponentialT<G>::ExponentialT(const G &gen)
+	: inherited(gen)
+{}
+
+
 //////////////////////////////////////////////////////////////////////////
 /// @brief Generate the random number.
 /**
@@ -706,7 +2882,8 @@ Exponential::Exponential(seed_type seed)
 @param stdev The standard deviation.
 @return The random number.
 */
-Exponential::value_type Exponential::operator()(value_type stdev)
+template<typename G>
+typename ExponentialT<G>::value_type ExponentialT<G>::operator()(value_type stdev)
 {
 	return stdev * (*this)();
 }
@@ -720,7 +2897,8 @@ Exponential::value_type Exponential::operator()(value_type stdev)
 
 @return The random number.
 */
-Exponential::value_type Exponential::operator()()
+template<typename G>
+typename ExponentialT<G>::value_type ExponentialT<G>::operator()()
 {
 	value_type x;
 
@@ -730,6 +2908,144 @@ Exponential::value_type Exponential::operator()()
 	return -log(x);
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the exponential distributed random numbers with
+	standard deviation @a stdev.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+@param stdev The standard deviation.
+*/
+template<typename G>
+void ExponentialT<G>::fill(value_type *first, size_t N, value_type stdev)
+{
+	for (size_t i = 0; i < N; ++i)
+		first[i] = stdev * (*this)();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N)
+	by the exponential distributed random numbers with
+	unit standard deviation.
+
+@param first Begin of the output buffer.
+@param N The buffer size.
+*/
+template<typename G>
+void ExponentialT<G>::fill(value_type *first, size_t N)
+{
+	fill(first, N, 1.0);
+}
+
 	} // Exponential
 
+
+	// Bits
+	namespace rnd
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The default constructor.
+/**
+		The default constructor uses the seed value
+	from the global Random generator.
+*/
+template<typename G>
+BitsT<G>::BitsT()
+	: inherited(g_seed())
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The main constructor.
+/**
+		This constructor initializes the generator by @a seed value.
+
+@param seed The seed value.
+*/
+template<typename G>
+BitsT<G>::BitsT(seed_type seed)
+	: inherited(seed)
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Create from the discrete PRS generator.
+/**
+		This constructor initializes the generator by
+	the discrete PRS generator @a gen state.
+
+@param gen The discrete PRS generator.
+*/
+template<typename G>
+BitsT<G>::BitsT(const G &gen)
+	: inherited(gen)
+{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Generate 64 random bits.
+/**
+		The first 32-bit random number is used as
+	the low half of the result.
+
+@return The packed random bits.
+*/
+template<typename G>
+typename BitsT<G>::value_type BitsT<G>::operator()()
+{
+	const value_type lo = value_type(inherited::operator()() & 0xFFFFFFFFUL);
+	const value_type hi = value_type(inherited::operator()() & 0xFFFFFFFFUL);
+	return lo | (hi << 32);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Fill the buffer.
+/**
+		This method fills the buffer [@a first, @a first + @a N_words)
+	by the packed random bits. The result is the same as
+	the sequence of @a N_words operator()() calls.
+
+@param first Begin of the output buffer.
+@param N_words The number of words.
+*/
+template<typename G>
+void BitsT<G>::fill(value_type *first, size_t N_words)
+{
+	for (size_t i = 0; i < N_words; ++i)
+		first[i] = (*this)();
+}
+
+	} // Bits
+
+
+	// explicit instantiation
+	namespace rnd
+	{
+
+template class UniformT<Random>;
+template class NormalT<Random>;
+template class ExponentialT<Random>;
+template class BitsT<Random>;
+
+template class UniformT<Philox>;
+template class NormalT<Philox>;
+template class ExponentialT<Philox>;
+template class BitsT<Philox>;
+
+template class UniformT<Xoshiro>;
+template class NormalT<Xoshiro>;
+template class ExponentialT<Xoshiro>;
+template class BitsT<Xoshiro>;
+
+	} // explicit instantiation
+
 } // omni namespace
@@ -20,6 +20,7 @@
 
 #include <omni/defs.hpp>
 #include <complex>
+#include <vector>
 
 namespace omni
 {
@@ -30,6 +31,13 @@ namespace omni
 /// @brief The main random value type.
 typedef size_t RandomValue;
 
+/// @brief The packed random bits type (64 bits).
+#if defined(_MSC_VER)
+typedef unsigned __int64 RandomBits;
+#else
+typedef unsigned long long RandomBits;
+#endif
+
 RandomValue rand(RandomValue lo, RandomValue up);
 RandomValue rand(RandomValue up);
 RandomValue rand();
@@ -38,6 +46,10 @@ RandomValue rand_max();
 void srand(RandomValue seed);
 RandomValue randomize();
 
+size_t thread_index();
+void set_thread_index(size_t index);
+RandomValue thread_seed(RandomValue seed, size_t index);
+
 double runif(double lo, double up);
 double runif(double up);
 double runif();
@@ -45,12 +57,16 @@ double runif();
 double rnorm(double mean, double stdev);
 double rnorm(double stdev);
 double rnorm();
+void rnorm(double *first, size_t N, double stdev);
 
 std::complex<double> wgn(double stdev);
 
 double rexp(double stdev);
 double rexp();
 
+RandomBits rbits();
+void rbits(RandomBits *first, size_t N_words);
+
 	} // auxiliary
 
 
@@ -68,11 +84,19 @@ double rexp();
 
 		The generator has a seed value.
 
+		The generator can be moved forward without generation of all
+	intermediate numbers (see jump() and jump_pow2() methods). So the
+	one sequence can be split into several non-overlapping
+	subsequences for parallel processing (see split() method).
+
 @see http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/emt.html
 @see M. Matsumoto and T. Nishimura, "Mersenne Twister: A 623-Dimensionally
 	Equidistributed Uniform Pseudo-Random Number Generator",
 	ACM Transactions on Modeling and Computer Simulation,
 	Vol. 8, No. 1, January 1998, pp 3--30.
+@see H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton, P. L'Ecuyer,
+	"Efficient Jump Ahead for F2-Linear Random Number Generators",
+	INFORMS Journal on Computing, Vol. 20, No. 3, 2008, pp 385--390.
 */
 class Random {
 public:
@@ -91,10 +115,20 @@ public:
 
 	static value_type rand_max();
 
+public:
+	void jump(size_t steps);
+	void jump_pow2(size_t log2_steps);
+	std::vector<Random> split(size_t N_streams,
+		size_t log2_stride = 64) const;
+
 private:
 	void srand(seed_type seed);
 	void reload();
 
+	void advance(size_t steps);
+	void jump(const std::vector<unsigned int> &poly,
+		size_t steps_mod, bool steps_big);
+
 	enum { N = 624 };
 	value_type m_rand[N];
 	size_t     m_curr;
@@ -103,6 +137,250 @@ private:
 	} // Random
 
 
+	// Philox
+	namespace rnd
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The counter-based PRS generator.
+/**
+		This class represents the Philox4x32-10 counter-based pseudo random
+	sequence (PRS) generator. The sequence is defined by the (@a seed,
+	@a stream, @a counter) triple: each counter value produces
+	the block of four 32-bit random numbers independently on all
+	other blocks. So any part of the sequence can be generated
+	without generation of all previous numbers.
+
+		The returned numbers are uniform distributed
+	random values in range [0, rand_max()].
+
+		The typical usage is one stream per simulation frame:
+
+@code
+	void frame(size_t k)
+	{
+		NormalT<Philox> noise(Philox(seed, k));
+		// ...
+	}
+@endcode
+
+		The frame's random numbers don't depend on the number of threads
+	and frames processing order.
+
+@see J.K. Salmon, M.A. Moraes, R.O. Dror, D.E. Shaw,
+	"Parallel Random Numbers: As Easy as 1, 2, 3",
+	Proceedings of SC'11, 2011.
+*/
+class Philox {
+public:
+	// value_type must be unsigned integer (at least 32 bit)
+	typedef RandomValue value_type;  ///< @brief The value type.
+	typedef value_type seed_type;    ///< @brief The seed type.
+	typedef size_t size_type;        ///< @brief The stream and counter type.
+
+public:
+	Philox();
+	explicit Philox(seed_type seed,
+		size_type stream = 0,
+		size_type counter = 0);
+
+public:
+	value_type operator()(value_type lo, value_type up);
+	value_type operator()(value_type up);
+	value_type operator()();
+
+	static value_type rand_max();
+
+public:
+	void seek(size_type counter);
+	size_type counter() const;
+	size_type stream() const;
+	seed_type seed() const;
+
+public:
+	static void generate(seed_type seed, size_type stream,
+		size_type counter, size_type N_blocks, unsigned int *out);
+
+private:
+	void reload();
+
+	enum { N_BLOCKS = 16, N = 4*N_BLOCKS };
+	unsigned int m_rand[N];
+	size_t       m_curr;
+
+	seed_type m_seed;
+	size_type m_stream;
+	size_type m_next; // next block
+};
+
+	} // Philox
+
+
+	// Xoshiro
+	namespace rnd
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The small-state PRS generator.
+/**
+		This class represents the xoshiro256** pseudo random sequence
+	(PRS) generator. The generator state is only four 64-bit words,
+	so thousands of independent generators (for example, one per
+	fading link) stay in cache. The period is 2^256-1.
+
+		Each 64-bit output is used as two 32-bit random numbers.
+	The returned numbers are uniform distributed random values
+	in range [0, rand_max()].
+
+		The seed value is expanded to the full state by
+	the SplitMix64 generator. The non-overlapping streams
+	can be created by jump() method, each jump is equivalent
+	to the 2^128 calls of next():
+
+@code
+	std::vector< NormalT<Xoshiro> > links;
+	Xoshiro gen(seed);
+	for (size_t k = 0; k < N_links; ++k)
+	{
+		links.push_back(NormalT<Xoshiro>(gen));
+		gen.jump();
+	}
+@endcode
+
+@see D. Blackman, S. Vigna, "Scrambled Linear Pseudorandom
+	Number Generators", ACM Trans. Math. Softw., 2021.
+*/
+class Xoshiro {
+public:
+	// value_type must be unsigned integer (at least 32 bit)
+	typedef RandomValue value_type;  ///< @brief The value type.
+	typedef value_type seed_type;    ///< @brief The seed type.
+	typedef RandomBits word_type;    ///< @brief The state word type.
+
+public:
+	Xoshiro();
+	explicit Xoshiro(seed_type seed);
+
+public:
+	value_type operator()(value_type lo, value_type up);
+	value_type operator()(value_type up);
+	value_type operator()();
+
+	static value_type rand_max();
+
+public:
+	word_type next();
+	void jump();
+	void long_jump();
+
+private:
+	void srand(seed_type seed);
+	void jump(const word_type poly[4]);
+
+	word_type m_s[4];
+	word_type m_half;    // the last 64-bit output
+	bool m_half_ready;   // is high half of m_half unused?
+};
+
+	} // Xoshiro
+
+
+	// Sobol
+	namespace rnd
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The Sobol quasi-random sequence generator.
+/**
+		This class represents the low-discrepancy Sobol sequence
+	of @a dim dimensional points in the unit cube. The Sobol points
+	fill the cube much more uniformly than pseudo random points,
+	so the Monte-Carlo integration (for example, BER estimation)
+	converges faster.
+
+		The generator has the same interface as the Uniform generator:
+	each operator()() call returns the next coordinate of the current
+	point, after the last coordinate the next point is started.
+	So the dimension should be equal to the number of random
+	values used per one simulation trial.
+
+		The normal() and fill_normal() methods return the normal
+	distributed numbers, each coordinate is transformed by
+	the inverse normal distribution function.
+
+		The sequence can be scrambled by random linear matrix scrambling
+	and random digital shift. The scrambled points are still the
+	low-discrepancy points, but the estimation error can be measured
+	by a few independently scrambled sequences.
+
+		The seek() and skip() methods move to any point in constant time,
+	so the sequence can be split between threads.
+
+	The direction numbers are taken from S. Joe and F.Y. Kuo
+	("new-joe-kuo-6" table), up to MAX_DIM dimensions are supported.
+
+@code
+	Sobol qmc(2*N_symbols, seed);  // scrambled
+	std::vector<double> noise(2*N_symbols);
+	for (size_t trial = 0; trial < N_trials; ++trial)
+		qmc.fill_normal(&noise[0], noise.size(), stdev);
+@endcode
+
+@see S. Joe, F.Y. Kuo, "Constructing Sobol sequences with better
+	two-dimensional projections", SIAM J. Sci. Comput. 30, 2008.
+*/
+class Sobol {
+public:
+	typedef double value_type;       ///< @brief The value type.
+	typedef RandomValue seed_type;   ///< @brief The scrambling seed type.
+	typedef size_t size_type;        ///< @brief The size type.
+
+	/// @brief The maximum number of dimensions.
+	enum { MAX_DIM = 256 };
+
+public:
+	explicit Sobol(size_type dim = 1);
+	Sobol(size_type dim, seed_type seed);
+
+public:
+	value_type operator()(value_type lo, value_type up);
+	value_type operator()(value_type up);
+	value_type operator()();
+
+	void fill(value_type *first, size_t N);
+
+public:
+	value_type normal(value_type stdev);
+	value_type normal();
+
+	void fill_normal(value_type *first, size_t N, value_type stdev);
+
+public:
+	void generate(size_type N_points, unsigned int *out);
+
+	void seek(size_type index);
+	void skip(size_type N_points);
+
+	size_type index() const;
+	size_type dim() const;
+
+private:
+	void init(size_type dim, bool scramble, seed_type seed);
+	unsigned int next();
+	void next_point();
+
+	size_type m_dim;
+	size_type m_index; // current point index
+	size_type m_curr;  // next coordinate of current point
+
+	std::vector<unsigned int> m_dir;   // direction numbers [32][dim]
+	std::vector<unsigned int> m_shift; // digital shift [dim]
+	std::vector<unsigned int> m_x;     // current point [dim]
+};
+
+	} // Sobol
+
+
 	// Uniform
 	namespace rnd
 	{
@@ -111,22 +389,34 @@ private:
 /// @brief The uniform distributed random numbers generator.
 /**
 	The random numbers are floating point numbers.
+
+	The template parameter @a G is the discrete PRS generator:
+	Random, Philox or Xoshiro. The generator should return at least
+	32-bit random numbers.
 */
-class Uniform: public Random {
-	typedef Random inherited;
+template<typename G>
+class UniformT: public G {
+	typedef G inherited;
 public:
+	typedef typename inherited::seed_type seed_type; ///< @brief The seed type.
 	typedef double value_type; ///< @brief The value type.
 
 public:
-	Uniform();
-	explicit Uniform(seed_type seed);
+	UniformT();
+	explicit UniformT(seed_type seed);
+	explicit UniformT(const G &gen);
 
 public:
 	value_type operator()(value_type lo, value_type up);
 	value_type operator()(value_type up);
 	value_type operator()();
+
+	void fill(value_type *first, size_t N);
 };
 
+/// @brief The uniform distributed random numbers generator (Mersenne Twister).
+typedef UniformT<Random> Uniform;
+
 	} // Uniform
 
 
@@ -138,26 +428,37 @@ public:
 /// @brief The normal distributed random numbers generator.
 /**
 	The random numbers are floating point numbers.
+
+@see UniformT
 */
-class Normal: public Uniform {
-	typedef Uniform inherited;
+template<typename G>
+class NormalT: public UniformT<G> {
+	typedef UniformT<G> inherited;
 public:
+	typedef typename inherited::seed_type seed_type; ///< @brief The seed type.
 	typedef double value_type; ///< @brief The value type.
 
 public:
-	Normal();
-	explicit Normal(seed_type seed);
+	NormalT();
+	explicit NormalT(seed_type seed);
+	explicit NormalT(const G &gen);
 
 public:
 	value_type operator()(value_type mean, value_type stdev);
 	value_type operator()(value_type stdev);
 	value_type operator()();
 
+	void fill(value_type *first, size_t N, value_type stdev);
+	void fill(value_type *first, size_t N);
+
 private:
 	value_type m_buf;
 	bool m_buf_empty;
 };
 
+/// @brief The normal distributed random numbers generator (Mersenne Twister).
+typedef NormalT<Random> Normal;
+
 	} // Normal
 
 
@@ -171,22 +472,81 @@ private:
 	The random numbers are floating point numbers.
 
 	The mean is equal to the standard deviation.
+
+@see UniformT
 */
-class Exponential: public Uniform {
-	typedef Uniform inherited;
+template<typename G>
+class ExponentialT: public UniformT<G> {
+	typedef UniformT<G> inherited;
 public:
+	typedef typename inherited::seed_type seed_type; ///< @brief The seed type.
 	typedef double value_type; ///< @brief The value type.
 
 public:
-	Exponential();
-	explicit Exponential(seed_type seed);
+	ExponentialT();
+	explicit ExponentialT(seed_type seed);
+	explicit ExponentialT(const G &gen);
 
 public:
 	value_type operator()(value_type stdev);
 	value_type operator()();
+
+	void fill(value_type *first, size_t N, value_type stdev);
+	void fill(value_type *first, size_t N);
+};
+
+/// @brief The exponential distributed random numbers generator (Mersenne Twister).
+typedef ExponentialT<Random> Exponential;
+
+	} // Exponential
+
+
+	// Bits
+	namespace rnd
+	{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The packed random bits generator.
+/**
+		This generator produces 64 random bits per draw
+	packed into one RandomBits word. It's much cheaper
+	than the one random number per bit.
+
+		Use util::unpack_lsb() or util::BitIterator to pass
+	the packed bits to the "one int per bit" interfaces:
+
+@code
+	Bits gen;
+	std::vector<RandomBits> words(N_bits/64 + 1);
+	gen.fill(&words[0], words.size());
+
+	util::BitIterator<RandomBits> first(&words[0]);
+	mod.modulate_bits(first, first + N_bits, symbols.begin());
+@endcode
+
+@see UniformT
+*/
+template<typename G>
+class BitsT: public G {
+	typedef G inherited;
+public:
+	typedef typename inherited::seed_type seed_type; ///< @brief The seed type.
+	typedef RandomBits value_type; ///< @brief The value type.
+
+public:
+	BitsT();
+	explicit BitsT(seed_type seed);
+	explicit BitsT(const G &gen);
+
+public:
+	value_type operator()();
+	void fill(value_type *first, size_t N_words);
 };
 
-	} // Exponential interface
+/// @brief The packed random bits generator (Mersenne Twister).
+typedef BitsT<Random> Bits;
+
+	} // Bits interface
 
 } // omni namespace
 
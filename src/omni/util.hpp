@@ -24,8 +24,11 @@
 #include <omni/defs.hpp>
 
 #include <assert.h>
+#include <stddef.h>
 #include <stdlib.h>
 
+#include <iterator>
+
 namespace omni
 {
 	/// @brief Utility.
@@ -727,6 +730,233 @@ template<typename T>
 	return res;
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Unpack the packed bits (LSB first).
+/**
+		This function unpacks the first @a Nbits bits of the packed words
+	[@a first, @a first + (@a Nbits + 8*sizeof(T) - 1) / (8*sizeof(T)))
+	to the output bit sequence [@a out, @a out + @a Nbits). The bits of
+	each word are unpacked from the least significant bit.
+
+		For example, the following code unpacks 100 random bits:
+
+@code
+	rnd::RandomBits words[2] = { rnd::rbits(), rnd::rbits() };
+	std::vector<int> bits(100);
+	unpack_lsb(words, bits.size(), bits.begin());
+@endcode
+
+@note The template argument @a T should be unsigned integer type.
+
+@param[in] first Begin of the packed words.
+@param[in] Nbits Total number of bits to unpack.
+@param[in] out Begin of the output bit sequence.
+@return End of the output bit sequence.
+*/
+template<typename T, typename Out>
+	Out unpack_lsb(const T *first, size_t Nbits, Out out)
+{
+	const size_t W = 8*sizeof(T);
+
+	for (; W <= Nbits; Nbits -= W)
+		out = de2bi_lsb(*first++, W, out);
+	if (Nbits)
+		out = de2bi_lsb(*first, Nbits, out);
+
+	return out;
+}
+
+/// @}
+	}
+
+
+	namespace util
+	{
+/// @name Packed bits iterator
+/// @{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The packed bits iterator.
+/**
+		This read-only random access iterator represents the packed words
+	as the bit sequence (LSB first). Each bit is dereferenced as @b int
+	value (0 or 1), so the packed bits can be used directly with
+	the "one int per bit" interfaces:
+
+@code
+	std::vector<rnd::RandomBits> words(16);
+	rnd::rbits(&words[0], words.size());
+
+	BitIterator<rnd::RandomBits> first(&words[0]);
+	std::vector<int> bits(first, first + 64*words.size());
+@endcode
+
+@note The template argument @a T should be unsigned integer type.
+*/
+template<typename T>
+class BitIterator
+{
+	typedef BitIterator<T> this_type;
+	enum { W = 8*sizeof(T) };
+
+public: // typedefs
+	typedef std::random_access_iterator_tag iterator_category; ///< @brief The iterator category.
+	typedef ptrdiff_t difference_type; ///< @brief The difference type.
+	typedef int value_type;            ///< @brief The value type.
+	typedef int reference;             ///< @brief The reference type.
+	typedef const int* pointer;        ///< @brief The pointer type.
+
+public:
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The default constructor.
+	BitIterator()
+		: m_base(0), m_pos(0)
+	{}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief The main constructor.
+/**
+@param base The packed words.
+@param pos The bit position.
+*/
+	explicit BitIterator(const T *base, difference_type pos = 0)
+		: m_base(base), m_pos(pos)
+	{}
+
+public: // access
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Dereference.
+/**
+@return The bit value.
+*/
+	reference operator*() const
+	{
+		return int(m_base[m_pos/W] >> (m_pos%W)) & 1;
+	}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get bit at specified index.
+/**
+@param i The bit index.
+@return The bit value.
+*/
+	reference operator[](difference_type i) const
+	{
+		return *(*this + i);
+	}
+
+public: // increment and decrement
+
+	/// @brief Prefix increment.
+	this_type& operator++()
+	{
+		++m_pos;
+		return *this;
+	}
+
+	/// @brief Prefix decrement.
+	this_type& operator--()
+	{
+		--m_pos;
+		return *this;
+	}
+
+	/// @brief Postfix increment.
+	this_type operator++(int)
+	{
+		this_type t(*this);
+		++m_pos;
+		return t;
+	}
+
+	/// @brief Postfix decrement.
+	this_type operator--(int)
+	{
+		this_type t(*this);
+		--m_pos;
+		return t;
+	}
+
+	/// @brief Move forward.
+	this_type& operator+=(difference_type d)
+	{
+		m_pos += d;
+		return *this;
+	}
+
+	/// @brief Move backward.
+	this_type& operator-=(difference_type d)
+	{
+		m_pos -= d;
+		return *this;
+	}
+
+	/// @brief Move forward.
+	this_type operator+(difference_type d) const
+	{
+		return this_type(m_base, m_pos + d);
+	}
+
+	/// @brief Move backward.
+	this_type operator-(difference_type d) const
+	{
+		return this_type(m_base, m_pos - d);
+	}
+
+	/// @brief The distance between two iterators.
+	difference_type operator-(const this_type &other) const
+	{
+		return m_pos - other.m_pos;
+	}
+
+public: // comparison
+
+	/// @brief Are iterators equal?
+	bool operator==(const this_type &other) const
+	{
+		return m_pos == other.m_pos;
+	}
+
+	/// @brief Are iterators non-equal?
+	bool operator!=(const this_type &other) const
+	{
+		return m_pos != other.m_pos;
+	}
+
+	/// @brief Is less than?
+	bool operator<(const this_type &other) const
+	{
+		return m_pos < other.m_pos;
+	}
+
+	/// @brief Is greater than?
+	bool operator>(const this_type &other) const
+	{
+		return m_pos > other.m_pos;
+	}
+
+	/// @brief Is less than or equal?
+	bool operator<=(const this_type &other) const
+	{
+		return m_pos <= other.m_pos;
+	}
+
+	/// @brief Is greater than or equal?
+	bool operator>=(const this_type &other) const
+	{
+		return m_pos >= other.m_pos;
+	}
+
+private:
+	const T *m_base; ///< @brief The packed words.
+	difference_type m_pos; ///< @brief The bit position.
+};
+
 /// @}
 	}
 
@@ -0,0 +1,471 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/DFT.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/DFT.h>
+#include <omni/dsp/DFT_fixed.h>
+#include <omni/matrix.hpp>
+#include <omni/conf.hpp>
+#include <omni/util.hpp>
+#include <omni/SIMD.hpp>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::DFT unit test.
+class DFTTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::DFT";
+	}
+
+private:
+
+	// test signal
+	template<typename T>
+	static std::vector< std::complex<T> > signal(size_t N)
+	{
+		std::vector< std::complex<T> > x(N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = std::complex<T>(T(sin(0.3*i + 0.1*i*i)), T(cos(1.7*i)));
+
+		return x;
+	}
+
+	// direct DFT (reference)
+	template<typename T>
+	static std::vector< std::complex<T> > direct(const std::vector< std::complex<T> > &x, bool is_fwd)
+	{
+		const size_t N = x.size();
+		std::vector< std::complex<T> > y(N);
+
+		for (size_t k = 0; k < N; ++k)
+		{
+			std::complex<double> sum;
+			for (size_t n = 0; n < N; ++n)
+			{
+				const double a = (is_fwd ? -2 : 2) * omni::util::PI * double((n*k)%N) / N;
+				sum += std::complex<double>(x[n]) * std::polar(1.0, a);
+			}
+
+			y[k] = std::complex<T>(sum);
+		}
+
+		return y;
+	}
+
+	// relative error
+	template<typename T>
+	static double error(const std::vector< std::complex<T> > &x, const std::vector< std::complex<T> > &y)
+	{
+		double err = 0.0, nrm = 0.0;
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			err += std::norm(std::complex<double>(x[i]) - std::complex<double>(y[i]));
+			nrm += std::norm(std::complex<double>(y[i]));
+		}
+
+		return sqrt(err / nrm);
+	}
+
+	// check forward and inverse transforms
+	template<typename T>
+	static bool check(size_t N, double eps)
+	{
+		const std::vector< std::complex<T> > x = signal<T>(N);
+		omni::dsp::DFT<T> ft(N, T(1), T(1));
+
+		std::vector< std::complex<T> > y = x;
+		ft.forward(y);
+		if (eps < error(y, direct(x, true)))
+			return false;
+
+		y = x;
+		ft.inverse(y);
+		if (eps < error(y, direct(x, false)))
+			return false;
+
+		// out-of-place: strided input, contiguous and strided output
+		std::vector< std::complex<T> > xs(3*N), ys(2*N), z(N);
+		for (size_t i = 0; i < N; ++i)
+			xs[3*i] = x[i];
+
+		ft.forward(&xs[0], 3, &z[0], 1);
+		if (eps < error(z, direct(x, true)))
+			return false;
+
+		ft.inverse(&xs[0], 3, &ys[0], 2);
+		for (size_t i = 0; i < N; ++i)
+			z[i] = ys[2*i];
+		if (eps < error(z, direct(x, false)))
+			return false;
+
+		return true;
+	}
+
+	// check large transform: several bins and the round trip
+	template<typename T>
+	static bool check_large(size_t N, double eps)
+	{
+		const std::vector< std::complex<T> > x = signal<T>(N);
+		omni::dsp::DFT<T> ft(N, T(1), T(1.0/N));
+
+		std::vector< std::complex<T> > y = x;
+		ft.forward(y);
+
+		const size_t bins[] = { 0, 1, 7, N/3, N-1 };
+		for (size_t i = 0; i < sizeof(bins)/sizeof(bins[0]); ++i)
+		{
+			const size_t k = bins[i];
+
+			std::complex<double> sum;
+			for (size_t n = 0; n < N; ++n)
+				sum += std::complex<double>(x[n]) * std::polar(1.0,
+					-2 * omni::util::PI * double((n*k)%N) / N);
+
+			if (eps*sqrt(double(N)) < std::abs(std::complex<double>(y[k]) - sum))
+				return false;
+		}
+
+		ft.inverse(y);
+		if (eps < error(y, x))
+			return false;
+
+		return true;
+	}
+
+	// check batch against the single transforms
+	template<typename T>
+	static bool check_batch(size_t N, size_t count, size_t distance)
+	{
+		std::vector< std::complex<T> > x = signal<T>(count*distance);
+		std::vector< std::complex<T> > y = x;
+
+		omni::dsp::DFT<T> ft(N);
+		ft.forward_batch(&y[0], count, distance);
+		for (size_t i = 0; i < count; ++i)
+			ft.forward(&x[i*distance]);
+		if (x != y)
+			return false;
+
+		ft.inverse_batch(&y[0], count, distance);
+		for (size_t i = 0; i < count; ++i)
+			ft.inverse(&x[i*distance]);
+		if (x != y)
+			return false;
+
+		return true;
+	}
+
+	// check real forward and inverse transforms
+	template<typename T>
+	static bool check_real(size_t N, double eps)
+	{
+		const std::vector< std::complex<T> > z = signal<T>(N);
+		std::vector<T> x(N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = z[i].real();
+
+		omni::dsp::RDFT<T> ft(N, T(1), T(1)/N);
+
+		std::vector< std::complex<T> > y;
+		ft.forward(x, y);
+
+		std::vector< std::complex<T> > ref = direct(std::vector< std::complex<T> >(x.begin(), x.end()), true);
+		ref.resize(N/2 + 1);
+		if (eps < error(y, ref))
+			return false;
+
+		std::vector<T> xx;
+		ft.inverse(y, xx);
+		if (eps < error(std::vector< std::complex<T> >(xx.begin(), xx.end()),
+				std::vector< std::complex<T> >(x.begin(), x.end())))
+			return false;
+
+		return true;
+	}
+
+	// check 2-D transforms (separable direct DFT)
+	template<typename T>
+	static bool check_2d(size_t N_rows, size_t N_cols, double eps)
+	{
+		const std::vector< std::complex<T> > z = signal<T>(N_rows*N_cols);
+		omni::mx::Matrix< std::complex<T> > x(N_rows, N_cols);
+		for (size_t r = 0; r < N_rows; ++r)
+		for (size_t c = 0; c < N_cols; ++c)
+			x.at(r, c) = z[r*N_cols + c];
+
+		std::vector< std::complex<T> > ref(z.size());
+		for (size_t r = 0; r < N_rows; ++r)
+		{
+			const std::vector< std::complex<T> > row = direct(
+				std::vector< std::complex<T> >(z.begin() + r*N_cols,
+					z.begin() + (r+1)*N_cols), true);
+			std::copy(row.begin(), row.end(), ref.begin() + r*N_cols);
+		}
+		for (size_t c = 0; c < N_cols; ++c)
+		{
+			std::vector< std::complex<T> > col(N_rows);
+			for (size_t r = 0; r < N_rows; ++r)
+				col[r] = ref[r*N_cols + c];
+			col = direct(col, true);
+			for (size_t r = 0; r < N_rows; ++r)
+				ref[r*N_cols + c] = col[r];
+		}
+
+		omni::dsp::DFT2D<T> ft(N_rows, N_cols, T(1), T(1)/(N_rows*N_cols));
+		std::vector< std::complex<T> > y(z.size());
+
+		ft.forward(x);
+		for (size_t r = 0; r < N_rows; ++r)
+		for (size_t c = 0; c < N_cols; ++c)
+			y[r*N_cols + c] = x.at(r, c);
+		if (eps < error(y, ref))
+			return false;
+
+		ft.inverse(x);
+		for (size_t r = 0; r < N_rows; ++r)
+		for (size_t c = 0; c < N_cols; ++c)
+			y[r*N_cols + c] = x.at(r, c);
+		if (eps < error(y, z))
+			return false;
+
+		return true;
+	}
+
+	// check fixed-point transforms (block exponent)
+	static bool check_fixed(size_t N, double amp, double eps)
+	{
+		const std::vector< std::complex<double> > z = signal<double>(N);
+		std::vector< std::complex<short> > x(N);
+		std::vector< std::complex<double> > xd(N);
+		for (size_t i = 0; i < N; ++i)
+		{
+			x[i] = std::complex<short>(short(amp*z[i].real()), short(amp*z[i].imag()));
+			xd[i] = std::complex<double>(x[i].real(), x[i].imag());
+		}
+
+		omni::dsp::FixedDFT ft(N);
+
+		std::vector< std::complex<short> > y = x;
+		const int e1 = ft.forward(y);
+
+		std::vector< std::complex<double> > yd(N);
+		for (size_t i = 0; i < N; ++i)
+			yd[i] = std::complex<double>(y[i].real(), y[i].imag()) * ldexp(1.0, e1);
+		if (eps < error(yd, direct(xd, true)))
+			return false;
+
+		const int e2 = ft.inverse(y);
+		for (size_t i = 0; i < N; ++i)
+			yd[i] = std::complex<double>(y[i].real(), y[i].imag()) * ldexp(1.0, e1+e2) / double(N);
+		if (2*eps < error(yd, xd))
+			return false;
+
+		return true;
+	}
+
+	// check SSSE3 fixed-point stage against general version
+	/*
+			Both versions should give exactly the same output and
+		maximum for all stages, shifts and directions. The input
+		has extreme values to check the saturation.
+	*/
+	static bool check_fixed_stage(size_t N)
+	{
+		const std::vector< std::complex<double> > z = signal<double>(N);
+		std::vector<short> x(2*N);
+		for (size_t i = 0; i < N; ++i)
+		{
+			x[2*i+0] = short(32767*z[i].real());
+			x[2*i+1] = short(32767*z[i].imag());
+		}
+		x[0] = -32768; x[3] = 32767;
+		x[2*N-1] = -32768; x[2*N-2] = -32768;
+
+		for (size_t h = 1; h < N; h *= 2)
+		{
+			// twiddles: { c, c } and { s, -s } pairs
+			std::vector<short> cc(2*h), ss(2*h);
+			for (size_t k = 0; k < h; ++k)
+			{
+				const double a = omni::util::PI * double(k) / double(h);
+				cc[2*k] = cc[2*k+1] = short(floor(32767*cos(a) + 0.5));
+				ss[2*k] = short(floor(32767*sin(a) + 0.5));
+				ss[2*k+1] = short(-ss[2*k]);
+			}
+
+			for (int shift = 0; shift <= 2; ++shift)
+			for (int dir = 0; dir < 2; ++dir)
+			{
+				std::vector<short> y1 = x, y2 = x;
+				const int m1 = omni::dsp::details::fix_stage(&y1[0], N, h,
+					&cc[0], &ss[0], shift, 0 != dir, false);
+				const int m2 = omni::dsp::details::fix_stage(&y2[0], N, h,
+					&cc[0], &ss[0], shift, 0 != dir, true);
+
+				if (m1 != m2 || y1 != y2)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		// all sizes: power of two, mixed-radix, direct and Bluestein
+		const size_t sizes[] = { 1, 2, 3, 5, 7, 8, 12, 13, 49, 60,
+			64, 97, 210, 600, 1024, 1200, 1536, 1999 };
+
+		os << " double testing..........";
+		for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+			TEST(check<double>(sizes[i], 1e-12));
+
+		// Bluestein with 2^21 convolution (four-step size in multi-thread mode)
+		TEST(check_large<double>(524309, 1e-12));
+		os << "done\n";
+
+		os << " float testing...........";
+		for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+			TEST(check<float>(sizes[i], 1e-5));
+		os << "done\n";
+
+		os << " batch testing...........";
+		{
+			TEST(check_batch<double>(60, 7, 64));
+
+			// several BATCH_GRAIN: split across threads (multi-thread mode)
+			TEST(check_batch<double>(1000, 80, 1000));
+			TEST(check_batch<double>(1009, 80, 1010));
+			TEST(check_batch<float>(1024, 100, 1024));
+		}
+		os << "done\n";
+
+		os << " 2-D testing.............";
+		TEST(check_2d<double>(1, 1, 1e-12));
+		TEST(check_2d<double>(8, 8, 1e-12));
+		TEST(check_2d<double>(12, 35, 1e-12));
+		TEST(check_2d<double>(64, 5, 1e-12));
+		TEST(check_2d<float>(60, 48, 1e-5));
+		TEST(check_2d<double>(256, 300, 1e-12));
+		os << "done\n";
+
+		os << " planner testing.........";
+		{
+			using omni::dsp::DFT_Planner;
+			typedef omni::conf::ItemT<std::string> Wisdom;
+
+			// forced plans
+			Wisdom w1;
+			w1.parse("<float> 2048 = \"mixed\" 41 = \"direct\" </float>"
+				"<double> 2048 = \"fourstep\" 1000 = \"fourstep\" 4096 = \"fourstep\" </double>");
+			DFT_Planner::import_wisdom(w1);
+			TEST(check<float>(2048, 1e-5));
+			TEST(check<float>(41, 1e-5));
+			TEST(check<double>(2048, 1e-12));
+			TEST(check<double>(1000, 1e-12));
+			TEST(check<double>(4096, 1e-12)); // square: in-place transpose
+
+			// plans not suitable for the size are ignored
+			Wisdom w0;
+			w0.parse("<double> 300 = \"radix4\" 97 = \"mixed\" 128 = \"bluestein\""
+				" 24 = \"bluestein\" 0 = \"direct\" 45 = \"unknown\" </double>");
+			DFT_Planner::import_wisdom(w0);
+			TEST(check<double>(300, 1e-12));
+			TEST(check<double>(97, 1e-12));
+			TEST(check<double>(128, 1e-12));
+			TEST(check<double>(24, 1e-12));
+
+			// measured plans
+			DFT_Planner::set_mode(DFT_Planner::MEASURE);
+			DFT_Planner::plan<double>(48);
+			DFT_Planner::plan<double>(37);
+			DFT_Planner::set_mode(DFT_Planner::ESTIMATE);
+			TEST(check<double>(48, 1e-12));
+			TEST(check<double>(37, 1e-12));
+
+			Wisdom w2;
+			DFT_Planner::export_wisdom(w2);
+			TEST(w2["float"].getv("2048") == "mixed");
+			TEST(w2["float"].getv("41") == "direct");
+			TEST(w2["double"].getv("2048") == "fourstep");
+			TEST(w2["double"].getv("1000") == "fourstep");
+			TEST(w2["double"].getv("4096") == "fourstep");
+			TEST(w2["double"].exists("48"));
+			TEST(w2["double"].exists("37"));
+			TEST(!w2["double"].exists("300") && !w2["double"].exists("97"));
+			TEST(!w2["double"].exists("128") && !w2["double"].exists("24"));
+			TEST(!w2["double"].exists("0") && !w2["double"].exists("45"));
+
+			// back to the estimated plans
+			DFT_Planner::clear_wisdom();
+			Wisdom w3;
+			DFT_Planner::export_wisdom(w3);
+			TEST(w3["double"].empty() && w3["float"].empty());
+			TEST(check<double>(2048, 1e-12));
+			TEST(check<double>(1000, 1e-12));
+		}
+		os << "done\n";
+
+		os << " fixed testing...........";
+		for (size_t N = 2; N <= 4096; N *= 2)
+		{
+			TEST(check_fixed(N, 100.0, 1e-2));
+			TEST(check_fixed(N, 32000.0, 1e-2));
+		}
+		if (omni::SIMD::Capability::SSSE3)
+		{
+			for (size_t N = 2; N <= 1024; N *= 2)
+				TEST(check_fixed_stage(N));
+		}
+		os << "done\n";
+
+		os << " real testing............";
+		for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+		{
+			TEST(check_real<double>(sizes[i], 1e-12));
+			TEST(check_real<float>(sizes[i], 1e-5));
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	DFTTest g_DFTTest;
+
+} // unit test
@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/FHT.hpp>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/FHT.hpp>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::fht unit test.
+class FHTTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::fht";
+	}
+
+private:
+
+	// test signal
+	template<typename T>
+	static std::vector<T> signal(size_t N)
+	{
+		std::vector<T> x(N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = T(100*sin(0.3*i + 0.1*i*i));
+
+		return x;
+	}
+
+	// check against the common version
+	template<typename T>
+	static bool check(size_t N, double eps)
+	{
+		const std::vector<T> x = signal<T>(N);
+
+		std::vector<T> ref = x;
+		omni::dsp::details::ifht_T(&ref[0], N);
+
+		std::vector<T> y = x;
+		omni::dsp::ifht(y);
+		for (size_t i = 0; i < N; ++i)
+			if (eps*N < fabs(double(y[i]) - double(ref[i])))
+				return false;
+
+		// batch: 11 arrays (the small ones are interleaved by 8)
+		const size_t count = 11;
+		const size_t distance = N + 3;
+		std::vector<T> z(count*distance);
+		for (size_t k = 0; k < count; ++k)
+			for (size_t i = 0; i < N; ++i)
+				z[k*distance + i] = T(x[i] + T(k));
+
+		omni::dsp::ifht_batch(&z[0], N, count, distance);
+		for (size_t k = 0; k < count; ++k)
+		{
+			std::vector<T> r(N);
+			for (size_t i = 0; i < N; ++i)
+				r[i] = T(x[i] + T(k));
+			omni::dsp::details::ifht_T(&r[0], N);
+
+			for (size_t i = 0; i < N; ++i)
+				if (eps*N < fabs(double(z[k*distance + i]) - double(r[i])))
+					return false;
+
+			// the gap is untouched
+			for (size_t i = N; i < distance; ++i)
+				if (z[k*distance + i] != T())
+					return false;
+		}
+
+		return true;
+	}
+
+	// check normalized transform
+	template<typename T>
+	static bool check_norm(size_t N, double eps)
+	{
+		const std::vector<T> x = signal<T>(N);
+
+		std::vector<T> y = x;
+		omni::dsp::fht(y);
+		omni::dsp::ifht(y);
+		for (size_t i = 0; i < N; ++i)
+			if (eps < fabs(double(y[i]) - double(x[i])))
+				return false;
+
+		// batch: 9 arrays
+		std::vector<T> z(9*N);
+		for (size_t k = 0; k < 9; ++k)
+			std::copy(x.begin(), x.end(), z.begin() + k*N);
+
+		omni::dsp::fht_batch(&z[0], N, 9, N);
+		omni::dsp::ifht_batch(&z[0], N, 9, N);
+		for (size_t i = 0; i < z.size(); ++i)
+			if (eps < fabs(double(z[i]) - double(x[i%N])))
+				return false;
+
+		return true;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		os << " transform testing.......";
+		for (size_t N = 1; N <= 32*1024; N *= 2)
+		{
+			TEST(check<double>(N, 1e-12));
+			TEST(check<float>(N, 1e-4));
+			TEST(check<short>(N, 0.0));
+			TEST(check<int>(N, 0.0));
+		}
+		os << "done\n";
+
+		os << " normalized testing......";
+		for (size_t N = 1; N <= 32*1024; N *= 4)
+		{
+			TEST(check_norm<double>(N, 1e-10));
+			TEST(check_norm<float>(N, 1e-2));
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	FHTTest g_FHTTest;
+
+} // unit test
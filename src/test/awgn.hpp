@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/awgn.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/awgn.h>
+#include <omni/rand.hpp>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::awgn() unit test.
+class AwgnTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::awgn";
+	}
+
+private:
+
+	// check the noise power of the AWGN channel
+	/*
+			The signal is constant, so the noise is (y - x). Both
+		real and imaginary parts should have N0/2 power and zero mean.
+		The buffer length N isn't a multiple of the noise block.
+	*/
+	template<typename T>
+	static bool check(size_t N, double EsN0_dB, double Es)
+	{
+		const std::complex<T> s(T(0.3), T(-0.7));
+		std::vector< std::complex<T> > x(N, s);
+		omni::dsp::awgn(&x[0], N, EsN0_dB, Es);
+
+		double m_re = 0.0, m_im = 0.0;
+		double p_re = 0.0, p_im = 0.0;
+		for (size_t i = 0; i < N; ++i)
+		{
+			const double re = double(x[i].real()) - double(s.real());
+			const double im = double(x[i].imag()) - double(s.imag());
+			m_re += re; p_re += re*re;
+			m_im += im; p_im += im*im;
+		}
+		m_re /= N; p_re /= N;
+		m_im /= N; p_im /= N;
+
+		const double N0 = Es / pow(10.0, EsN0_dB/10.0);
+		const double eps = 6.0/sqrt(double(N)); // relative, about 4 sigma
+
+		return fabs(p_re + p_im - N0) < eps*N0
+			&& fabs(2.0*p_re - N0) < 1.5*eps*N0
+			&& fabs(2.0*p_im - N0) < 1.5*eps*N0
+			&& fabs(m_re) < eps*sqrt(N0) && fabs(m_im) < eps*sqrt(N0);
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		typedef std::complex<double> Complex;
+		typedef std::complex<float> ComplexF;
+
+		omni::rnd::srand(2014);
+
+		os << " double testing..........";
+		{
+			TEST(check<double>(20001, 0.0, 1.0));
+			TEST(check<double>(20001, 6.0, 2.0));
+			TEST(check<double>(257, -10.0, 1.0));
+		}
+		os << "done\n";
+
+		os << " float testing...........";
+		{
+			TEST(check<float>(20001, 0.0, 1.0));
+			TEST(check<float>(20001, 6.0, 2.0));
+			TEST(check<float>(257, -10.0, 1.0));
+		}
+		os << "done\n";
+
+		os << " stdev testing...........";
+		{
+			// the same noise for both types
+			Complex x[3];
+			ComplexF y[3];
+
+			omni::rnd::srand(7);
+			omni::dsp::add_wgn(x, 3, 2.0);
+			omni::rnd::srand(7);
+			omni::dsp::add_wgn(y, 3, 2.0);
+
+			for (size_t i = 0; i < 3; ++i)
+				TEST(std::abs(Complex(y[i]) - x[i]) < 1e-5);
+
+			// stdev is given for the whole complex sample
+			omni::rnd::srand(7);
+			double n[6];
+			omni::rnd::rnorm(n, 6, 2.0/sqrt(2.0));
+			for (size_t i = 0; i < 3; ++i)
+				TEST(x[i] == Complex(n[2*i], n[2*i+1]));
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	AwgnTest g_AwgnTest;
+
+} // unit test
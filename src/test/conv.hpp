@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/conv.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/conv.h>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::Convolver unit test.
+class ConvTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::Convolver";
+	}
+
+private:
+
+	// test signal
+	template<typename T>
+	static std::vector< std::complex<T> > signal(size_t N, double f)
+	{
+		std::vector< std::complex<T> > x(N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = std::complex<T>(T(sin(f*i + 0.1*i*i)), T(cos(1.7*f*i)));
+
+		return x;
+	}
+
+	// direct filtering (reference)
+	template<typename T>
+	static std::vector< std::complex<T> > filter(const std::vector< std::complex<T> > &x,
+		const std::vector< std::complex<T> > &h)
+	{
+		std::vector< std::complex<T> > y(x.size());
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			std::complex<double> sum;
+			for (size_t k = 0; k < h.size() && k <= i; ++k)
+				sum += std::complex<double>(h[k]) * std::complex<double>(x[i-k]);
+			y[i] = std::complex<T>(sum);
+		}
+
+		return y;
+	}
+
+	// maximum error
+	template<typename T>
+	static double error(const std::vector< std::complex<T> > &x, const std::vector< std::complex<T> > &y)
+	{
+		double err = 0.0;
+		for (size_t i = 0; i < x.size(); ++i)
+			err = std::max(err, double(std::abs(x[i] - y[i])));
+
+		return err;
+	}
+
+	// check streaming filter with various block sizes
+	template<typename T>
+	static bool check(size_t N_coef, double eps)
+	{
+		const std::vector< std::complex<T> > h = signal<T>(N_coef, 0.7);
+		const std::vector< std::complex<T> > x = signal<T>(5000, 0.3);
+		const std::vector< std::complex<T> > ref = filter(x, h);
+
+		omni::dsp::Convolver<T> conv(h.begin(), h.end());
+		const size_t blocks[] = { 1, 7, 100, 1500, 3000 };
+
+		std::vector< std::complex<T> > y(x.size());
+		for (size_t i = 0, b = 0; i < x.size(); b = (b+1)%5)
+		{
+			const size_t n = std::min(blocks[b], x.size() - i);
+			conv.process(&x[i], &y[i], n);
+			i += n;
+		}
+		if (eps < error(y, ref))
+			return false;
+
+		// in-place
+		y = x;
+		conv.reset();
+		conv.process(y, y);
+		if (eps < error(y, ref))
+			return false;
+
+		return true;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		os << " filter testing..........";
+		{
+			TEST(check<double>(1, 1e-9));
+			TEST(check<double>(5, 1e-9));
+			TEST(check<double>(64, 1e-9));
+			TEST(check<double>(333, 1e-9));
+			TEST(check<float>(100, 1e-3));
+
+			// long filter uses FFT, short block and filter don't
+			const std::vector<double> h(500, 1.0);
+			omni::dsp::Convolver<double> conv(h.begin(), h.end());
+			TEST(conv.is_fft(1000));
+			TEST(!conv.is_fft(1));
+
+			const std::vector<double> g(3, 1.0);
+			TEST(!omni::dsp::Convolver<double>(g.begin(), g.end()).is_fft(1000));
+		}
+		os << "done\n";
+
+		os << " correlation testing.....";
+		{
+			const size_t M = 127, pos = 1000;
+			const std::vector< std::complex<double> > p = signal<double>(M, 0.9);
+			std::vector< std::complex<double> > x = signal<double>(3000, 0.2);
+			for (size_t i = 0; i < M; ++i)
+				x[pos + i] += 10.0*p[i];
+
+			omni::dsp::Convolver<double> corr(p.begin(), p.end(),
+				omni::dsp::Convolver<double>::CORRELATION);
+
+			std::vector< std::complex<double> > y;
+			corr.process(x, y);
+
+			size_t peak = 0;
+			for (size_t i = 0; i < y.size(); ++i)
+				if (std::abs(y[peak]) < std::abs(y[i]))
+					peak = i;
+			TEST(peak == pos + M-1);
+
+			std::complex<double> energy;
+			for (size_t i = 0; i < M; ++i)
+				energy += std::conj(p[i]) * x[pos + i];
+			TEST(std::abs(y[peak] - energy) < 1e-9);
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	ConvTest g_ConvTest;
+
+} // unit test
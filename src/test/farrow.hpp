@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/farrow.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/farrow.h>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::Farrow unit test.
+class FarrowTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::Farrow";
+	}
+
+private:
+
+	// test polynomial of given degree
+	template<typename T>
+	struct Value {
+		static T get(double t, size_t deg)
+		{
+			return T(poly(t, deg));
+		}
+	};
+
+	template<typename T>
+	struct Value< std::complex<T> > {
+		static std::complex<T> get(double t, size_t deg)
+		{
+			return std::complex<T>(T(poly(t, deg)), T(poly(20.0 - t, deg)));
+		}
+	};
+
+	static double poly(double t, size_t deg)
+	{
+		const double c[4] = { 0.5, 0.1, -0.002, 1e-5 };
+
+		double y = c[deg];
+		for (size_t p = deg; 0 < p; --p)
+			y = y*t + c[p-1];
+		return y;
+	}
+
+	// check the polynomial is reproduced at the output times
+	/*
+			The ratio is changed every block, the outputs
+		are compared since the time 1 (the history is zero).
+	*/
+	template<typename T, typename CF>
+	static bool check(omni::dsp::Farrow<T, CF> &f, size_t deg, double eps)
+	{
+		std::vector<T> x(300);
+		for (size_t i = 0; i < x.size(); ++i)
+			x[i] = Value<T>::get(double(i), deg);
+
+		const size_t blocks[] = { 1, 7, 64, 3, 100, 2 };
+		const double ratios[] = { 1.0, 3.3, 0.71, 1.0001, 0.25, 8.0 };
+
+		f.reset();
+		double t = 0.0;
+		size_t total = 0;
+		for (size_t i = 0, b = 0; i < x.size(); b = (b+1)%6)
+		{
+			const size_t n = std::min(blocks[b], x.size() - i);
+			f.set_ratio(ratios[b]);
+
+			std::vector<T> y(f.max_output(n));
+			const size_t count = f.filter(&x[i], n, y.empty() ? 0 : &y[0]);
+			if (y.size() < count)
+				return false;
+
+			for (size_t k = 0; k < count; ++k, t += 1.0/ratios[b])
+				if (1.0 <= t && eps < std::abs(y[k] - Value<T>::get(t, deg)))
+					return false;
+
+			total += count;
+			i += n;
+		}
+
+		// the last outputs wait for the next samples
+		const double last = double(x.size()) - double(f.taps())/2;
+		return last <= t && t < last + 8.0 && 100 < total;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		typedef std::complex<double> Complex;
+		typedef std::complex<float> ComplexF;
+		using omni::dsp::Farrow;
+
+		os << " Lagrange testing........";
+		{
+			Farrow<double, double> f1(1.0, Farrow<double, double>::LINEAR);
+			Farrow<double, double> f3(1.0);
+			TEST(2 == f1.taps() && 1 == f1.order());
+			TEST(4 == f3.taps() && 3 == f3.order());
+
+			TEST(check(f1, 1, 1e-12));
+			TEST(!check(f1, 2, 1e-6));
+			TEST(check(f3, 3, 1e-12));
+
+			Farrow<Complex, double> fc(1.0);
+			TEST(check(fc, 3, 1e-12));
+
+			Farrow<float, float> ff(1.0);
+			TEST(check(ff, 3, 1e-4));
+
+			Farrow<ComplexF, float> fcf(1.0);
+			TEST(check(fcf, 3, 1e-4));
+		}
+		os << "done\n";
+
+		os << " custom testing..........";
+		{
+			// linear interpolation, taps x[n], x[n+1]
+			std::vector<double> c(4);
+			c[0] = 1.0; c[1] = 0.0;
+			c[2] = -1.0; c[3] = 1.0;
+
+			Farrow<double, double> f(c, 2, 1.0);
+			TEST(check(f, 1, 1e-12));
+
+			// identity: ratio 1
+			double x[5] = { 1.0, 2.0, 4.0, 8.0, 16.0 }, y[8];
+			Farrow<double, double> g(1.0);
+			TEST(3 == g.filter(x, 5, y));
+			TEST(y[0] == 1.0 && y[1] == 2.0 && y[2] == 4.0);
+			TEST(2 == g.filter(x, 2, y));
+			TEST(y[0] == 8.0 && y[1] == 16.0);
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	FarrowTest g_FarrowTest;
+
+} // unit test
@@ -0,0 +1,311 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/filter.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/filter.h>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::FIR_Filter unit test.
+class FilterTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::FIR_Filter";
+	}
+
+private:
+
+	// test value
+	template<typename T>
+	struct Value {
+		static T get(size_t i, double f)
+		{
+			return T(sin(f*i + 0.1*i*i));
+		}
+	};
+
+	template<typename T>
+	struct Value< std::complex<T> > {
+		static std::complex<T> get(size_t i, double f)
+		{
+			return std::complex<T>(T(sin(f*i + 0.1*i*i)), T(cos(1.7*f*i)));
+		}
+	};
+
+	// check block filtering against sample by sample
+	template<typename T, typename CF>
+	static bool check(size_t N, double eps)
+	{
+		std::vector<CF> h(N);
+		for (size_t i = 0; i < N; ++i)
+			h[i] = Value<CF>::get(i, 0.7);
+
+		std::vector<T> x(1000);
+		for (size_t i = 0; i < x.size(); ++i)
+			x[i] = Value<T>::get(i, 0.3);
+
+		omni::dsp::FIR_Filter<T, CF> f1(h.begin(), h.end());
+		omni::dsp::FIR_Filter<T, CF> f2(h.begin(), h.end());
+
+		// blocks of various size and single samples, in-place
+		std::vector<T> y = x;
+		const size_t blocks[] = { 1, 5, 64, 3, 200 };
+		for (size_t i = 0, b = 0; i < x.size(); b = (b+1)%5)
+		{
+			const size_t n = std::min(blocks[b], x.size() - i);
+			if (1 == n)
+				y[i] = f2(y[i]);
+			else
+				f2.filter(&y[i], &y[i], n);
+			i += n;
+		}
+
+		for (size_t i = 0; i < x.size(); ++i)
+			if (eps < std::abs(f1(x[i]) - y[i]))
+				return false;
+
+		return true;
+	}
+
+	// check resampler against zero stuffing, filtering and decimation
+	template<typename T, typename CF>
+	static bool check_resampler(size_t N, size_t L, size_t M, double eps)
+	{
+		std::vector<CF> h(N);
+		for (size_t i = 0; i < N; ++i)
+			h[i] = Value<CF>::get(i, 0.7);
+
+		std::vector<T> x(500);
+		for (size_t i = 0; i < x.size(); ++i)
+			x[i] = Value<T>::get(i, 0.3);
+
+		// reference
+		omni::dsp::FIR_Filter<T, CF> f(h.begin(), h.end());
+		std::vector<T> ref;
+		for (size_t i = 0; i < x.size()*L; ++i)
+		{
+			const T y = f((0 == i%L) ? x[i/L] : T());
+			if (0 == i%M)
+				ref.push_back(y);
+		}
+
+		// blocks of various size
+		omni::dsp::FIR_Resampler<T, CF> r(h.begin(), h.end(), L, M);
+		std::vector<T> y(r.max_output(x.size()) + 1);
+		size_t count = 0;
+		const size_t blocks[] = { 1, 5, 64, 3, 200, 2 };
+		for (size_t i = 0, b = 0; i < x.size(); b = (b+1)%6)
+		{
+			const size_t n = std::min(blocks[b], x.size() - i);
+			const size_t k = r.filter(&x[i], n, &y[count]);
+			if (r.max_output(n) < k)
+				return false;
+			count += k;
+			i += n;
+		}
+
+		if (count != ref.size())
+			return false;
+		for (size_t i = 0; i < count; ++i)
+			if (eps < std::abs(ref[i] - y[i]))
+				return false;
+
+		// vector version after reset
+		r.reset();
+		std::vector<T> z;
+		r.filter(x, z);
+		if (z.size() != ref.size())
+			return false;
+		for (size_t i = 0; i < z.size(); ++i)
+			if (eps < std::abs(ref[i] - z[i]))
+				return false;
+
+		return true;
+	}
+
+	// check IIR cascade against direct form I, channels in parallel
+	template<typename T, typename CF>
+	static bool check_iir(size_t S, size_t C, double eps)
+	{
+		// stable sections, a0 = 2
+		std::vector<double> sos(6*S);
+		for (size_t s = 0; s < S; ++s)
+		{
+			const double r = 0.5 + 0.45*s/S, w = 0.3 + 0.5*s;
+			sos[6*s+0] = 0.2 + 0.1*s; sos[6*s+1] = -0.3; sos[6*s+2] = 0.15;
+			sos[6*s+3] = 2.0; sos[6*s+4] = -4.0*r*cos(w); sos[6*s+5] = 2.0*r*r;
+		}
+
+		const size_t N = 300;
+		std::vector<T> x(N*C);
+		for (size_t i = 0; i < x.size(); ++i)
+			x[i] = Value<T>::get(i, 0.3);
+
+		// reference: direct form I, one channel at once
+		std::vector<T> ref(x);
+		for (size_t c = 0; c < C; ++c)
+		for (size_t s = 0; s < S; ++s)
+		{
+			const double *h = &sos[6*s];
+			T x1 = T(), x2 = T(), y1 = T(), y2 = T();
+			for (size_t i = 0; i < N; ++i)
+			{
+				const T xi = ref[i*C + c];
+				const T y = (CF(h[0])*xi + CF(h[1])*x1 + CF(h[2])*x2
+					- CF(h[4])*y1 - CF(h[5])*y2) / CF(h[3]);
+				x2 = x1; x1 = xi;
+				y2 = y1; y1 = y;
+				ref[i*C + c] = y;
+			}
+		}
+
+		// blocks of various size, in-place
+		omni::dsp::IIR_Filter<T, CF> f(sos.begin(), sos.end(), C);
+		if (f.size() != S || f.channels() != C)
+			return false;
+
+		std::vector<T> y = x;
+		const size_t blocks[] = { 1, 5, 64, 3, 200 };
+		for (size_t i = 0, b = 0; i < N; b = (b+1)%5)
+		{
+			const size_t n = std::min(blocks[b], N - i);
+			f.filter(&y[i*C], &y[i*C], n);
+			i += n;
+		}
+
+		for (size_t i = 0; i < y.size(); ++i)
+			if (eps < std::abs(ref[i] - y[i]))
+				return false;
+
+		// sample by sample
+		if (1 == C)
+		{
+			f.reset();
+			for (size_t i = 0; i < N; ++i)
+				if (eps < std::abs(ref[i] - f(x[i])))
+					return false;
+		}
+
+		return true;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		typedef std::complex<double> Complex;
+		typedef std::complex<float> ComplexF;
+
+		os << " block testing...........";
+		{
+			const size_t sizes[] = { 1, 2, 7, 33 };
+			for (size_t k = 0; k < sizeof(sizes)/sizeof(sizes[0]); ++k)
+			{
+				const size_t N = sizes[k];
+				TEST((check<double, double>(N, 1e-12)));
+				TEST((check<float, float>(N, 1e-4)));
+				TEST((check<Complex, double>(N, 1e-12)));
+				TEST((check<ComplexF, float>(N, 1e-4)));
+				TEST((check<Complex, Complex>(N, 1e-12)));
+				TEST((check<ComplexF, ComplexF>(N, 1e-4)));
+				TEST((check<int, int>(N, 0)));
+			}
+
+			// transparent filter
+			omni::dsp::FIR_Filter<double, double> f;
+			double x[3] = { 1.0, 2.0, 3.0 }, y[3];
+			f.filter(x, y, 3);
+			TEST(y[0] == 1.0 && y[1] == 2.0 && y[2] == 3.0);
+		}
+		os << "done\n";
+
+		os << " polyphase testing.......";
+		{
+			const size_t ratio[][2] = { {1,1}, {4,1}, {1,3}, {3,2}, {2,5}, {8,1}, {1,8} };
+			const size_t sizes[] = { 1, 6, 33 };
+			for (size_t i = 0; i < sizeof(ratio)/sizeof(ratio[0]); ++i)
+			for (size_t k = 0; k < sizeof(sizes)/sizeof(sizes[0]); ++k)
+			{
+				const size_t N = sizes[k], L = ratio[i][0], M = ratio[i][1];
+				TEST((check_resampler<double, double>(N, L, M, 1e-12)));
+				TEST((check_resampler<float, float>(N, L, M, 1e-4)));
+				TEST((check_resampler<Complex, double>(N, L, M, 1e-12)));
+				TEST((check_resampler<ComplexF, float>(N, L, M, 1e-4)));
+				TEST((check_resampler<Complex, Complex>(N, L, M, 1e-12)));
+			}
+
+			// interpolator and decimator
+			const double h[3] = { 1.0, 2.0, 3.0 };
+			omni::dsp::FIR_Interpolator<double, double> fi(h, h+3, 2);
+			double x[2] = { 1.0, 10.0 }, y[4];
+			TEST(4 == fi.filter(x, 2, y));
+			TEST(y[0] == 1.0 && y[1] == 2.0 && y[2] == 13.0 && y[3] == 20.0);
+
+			omni::dsp::FIR_Decimator<double, double> fd(h, h+3, 2);
+			double z[2];
+			TEST(1 == fd.filter(x, 2, z) && z[0] == 1.0);
+			TEST(1 == fd.filter(x, 2, z) && z[0] == 24.0);
+		}
+		os << "done\n";
+
+		os << " IIR testing.............";
+		{
+			const size_t channels[] = { 1, 2, 3, 4, 5, 8, 9, 16 };
+			for (size_t k = 0; k < sizeof(channels)/sizeof(channels[0]); ++k)
+			for (size_t S = 1; S <= 4; S += 3)
+			{
+				const size_t C = channels[k];
+				TEST((check_iir<double, double>(S, C, 1e-10)));
+				TEST((check_iir<float, float>(S, C, 1e-3)));
+				TEST((check_iir<Complex, double>(S, C, 1e-10)));
+				TEST((check_iir<ComplexF, float>(S, C, 1e-3)));
+				TEST((check_iir<Complex, Complex>(S, C, 1e-10)));
+			}
+
+			// transparent filter
+			omni::dsp::IIR_Filter<double, double> f;
+			double x[3] = { 1.0, 2.0, 3.0 }, y[3];
+			f.filter(x, y, 3);
+			TEST(y[0] == 1.0 && y[1] == 2.0 && y[2] == 3.0 && f(5.0) == 5.0);
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	FilterTest g_FilterTest;
+
+} // unit test
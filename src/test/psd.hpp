@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/psd.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/psd.h>
+#include <omni/util.hpp>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::Welch unit test.
+class PSDTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::Welch";
+	}
+
+private:
+
+	// test signal
+	template<typename T>
+	static std::vector< std::complex<T> > signal(size_t N)
+	{
+		std::vector< std::complex<T> > x(N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = std::complex<T>(T(sin(0.3*i + 0.1*i*i)), T(cos(1.7*i)));
+
+		return x;
+	}
+
+	// averaged periodogram (reference)
+	static std::vector<double> welch(const std::vector< std::complex<double> > &x,
+		const std::vector<double> &w, size_t step)
+	{
+		const size_t N = w.size();
+		std::vector<double> psd(N);
+
+		double U = 0.0;
+		for (size_t n = 0; n < N; ++n)
+			U += w[n]*w[n];
+
+		size_t K = 0;
+		for (size_t s = 0; s+N <= x.size(); s += step, ++K)
+		for (size_t k = 0; k < N; ++k)
+		{
+			std::complex<double> X;
+			for (size_t n = 0; n < N; ++n)
+				X += x[s+n] * w[n] * std::polar(1.0, -2*omni::util::PI*double(n*k%N)/N);
+			psd[k] += std::norm(X);
+		}
+
+		for (size_t k = 0; k < N; ++k)
+			psd[k] /= U*K;
+
+		return psd;
+	}
+
+	// maximum relative error
+	template<typename T>
+	static double error(const std::vector<T> &x, const std::vector<double> &y)
+	{
+		double err = 0.0, nrm = 0.0;
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			err = std::max(err, fabs(x[i] - y[i]));
+			nrm = std::max(nrm, fabs(y[i]));
+		}
+
+		return err / nrm;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		using omni::dsp::Welch;
+
+		os << " estimate testing........";
+		{
+			const size_t N = 60, overlap = 25, L = 2000;
+			const std::vector< std::complex<double> > x = signal<double>(L);
+
+			// custom window, fed by blocks of various size
+			std::vector<double> w(N);
+			for (size_t n = 0; n < N; ++n)
+				w[n] = 1.0 + 0.01*n;
+
+			Welch<double> psd(w, overlap);
+			const size_t blocks[] = { 1, 13, 60, 200 };
+			for (size_t i = 0, b = 0; i < L; b = (b+1)%4)
+			{
+				const size_t n = std::min(blocks[b], L - i);
+				psd.put(&x[i], n);
+				i += n;
+			}
+
+			TEST(psd.count() == (L-N)/(N-overlap) + 1);
+			TEST(error(psd.psd(), welch(x, w, N-overlap)) < 1e-12);
+
+			// float version, standard window
+			std::vector< std::complex<float> > xf(x.begin(), x.end());
+			Welch<float> psdf(N, overlap, Welch<float>::HANN);
+			psdf.put(xf);
+
+			for (size_t n = 0; n < N; ++n)
+				w[n] = 0.5 - 0.5*cos(2*omni::util::PI*n/N);
+			TEST(error(psdf.psd(), welch(x, w, N-overlap)) < 1e-5);
+
+			psdf.reset();
+			TEST(psdf.count() == 0);
+		}
+		os << "done\n";
+
+		os << " tone testing............";
+		{
+			// A*exp(j*2*pi*k0*n/N): psd[k0] = N*A^2, zero elsewhere
+			const size_t N = 64, k0 = 5;
+			std::vector< std::complex<double> > x(10*N);
+			for (size_t n = 0; n < x.size(); ++n)
+				x[n] = 2.0 * std::polar(1.0, 2*omni::util::PI*double(k0*n%N)/N);
+
+			Welch<double> psd(N, N/2, Welch<double>::RECTANGULAR);
+			psd.put(x);
+
+			const std::vector<double> p = psd.psd();
+			TEST(psd.count() == 19);
+			TEST(fabs(p[k0] - 4.0*N) < 1e-9);
+			TEST(fabs(p[k0+1]) < 1e-9);
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	PSDTest g_PSDTest;
+
+} // unit test
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/rand.hpp>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/rand.hpp>
+#include <omni/util.hpp>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <vector>
+
+#if OMNI_MT
+#	include <windows.h>
+#endif // OMNI_MT
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::rnd unit test.
+class RandTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::rnd";
+	}
+
+
+#if OMNI_MT
+	// worker: draws numbers before and after srand() of the main thread
+	struct Worker {
+		volatile long ready; // set by the worker
+		volatile long go;    // set by the main thread
+		size_t index;
+		omni::rnd::RandomValue x[8];
+
+		static DWORD WINAPI run(void *arg)
+		{
+			Worker *w = static_cast<Worker*>(arg);
+
+			w->index = omni::rnd::thread_index();
+			for (size_t i = 0; i < 4; ++i)
+				w->x[i] = omni::rnd::rand();
+
+			w->ready = 1;
+			while (!w->go)
+				Sleep(0);
+
+			for (size_t i = 4; i < 8; ++i)
+				w->x[i] = omni::rnd::rand();
+			return 0;
+		}
+	};
+
+	// check the worker's numbers: "n" numbers of the epoch "seed" skipped
+	static bool check_worker(const Worker &w, omni::rnd::RandomValue seed, size_t n, size_t first)
+	{
+		omni::rnd::Random g(omni::rnd::thread_seed(seed, w.index));
+		for (size_t i = 0; i < n; ++i)
+			g();
+
+		for (size_t i = first; i < first+4; ++i)
+			if (w.x[i] != g())
+				return false;
+
+		return true;
+	}
+#endif // OMNI_MT
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		using namespace omni::rnd;
+
+		// global generators
+		os << " global testing..........";
+		{
+			omni::rnd::srand(12345);
+			const RandomValue x1 = omni::rnd::rand();
+			const double y1 = runif();
+
+			omni::rnd::srand(12345);
+			const RandomValue x2 = omni::rnd::rand();
+			const double y2 = runif();
+
+			TEST(x1 == x2);
+			TEST(y1 == y2);
+			TEST(thread_seed(12345, 0) == 12345);
+			TEST(thread_seed(12345, 1) != thread_seed(12345, 2));
+		}
+		os << "done\n";
+
+		// per-thread generators
+		os << " thread testing..........";
+		{
+			omni::rnd::srand(555);
+			set_thread_index(3);
+			TEST(3 == thread_index());
+
+			Random g(thread_seed(555, 3));
+			TEST(omni::rnd::rand() == g());
+
+			omni::rnd::srand(555); // re-seeded by epoch
+			Random g2(thread_seed(555, 3));
+			TEST(omni::rnd::rand() == g2());
+			set_thread_index(0);
+
+#if OMNI_MT
+			// two threads: different streams, both re-seeded by srand()
+			omni::rnd::srand(100);
+			Worker w[2];
+			HANDLE h[2];
+			for (size_t k = 0; k < 2; ++k)
+			{
+				w[k].ready = 0;
+				w[k].go = 0;
+				h[k] = CreateThread(0, 0, &Worker::run, &w[k], 0, 0);
+				TEST(0 != h[k]);
+			}
+			for (size_t k = 0; k < 2; ++k)
+				while (!w[k].ready)
+					Sleep(0);
+
+			omni::rnd::srand(200);
+			w[0].go = 1;
+			w[1].go = 1;
+			WaitForMultipleObjects(2, h, TRUE, INFINITE);
+			CloseHandle(h[0]);
+			CloseHandle(h[1]);
+
+			TEST(w[0].index != w[1].index);
+			TEST(w[0].x[0] != w[1].x[0]);
+			for (size_t k = 0; k < 2; ++k)
+			{
+				TEST(check_worker(w[k], 100, 0, 0));
+				TEST(check_worker(w[k], 200, 0, 4));
+			}
+
+			// the new thread continues the sequence of the exited one
+			Worker w3;
+			w3.go = 1;
+			HANDLE h3 = CreateThread(0, 0, &Worker::run, &w3, 0, 0);
+			TEST(0 != h3);
+			WaitForSingleObject(h3, INFINITE);
+			CloseHandle(h3);
+
+			TEST(w3.index == w[0].index || w3.index == w[1].index);
+			TEST(check_worker(w3, 200, 4, 0));
+			TEST(check_worker(w3, 200, 8, 4));
+#endif // OMNI_MT
+		}
+		os << "done\n";
+
+		// Philox known answers
+		os << " Philox testing..........";
+		{
+			unsigned int out[4];
+			Philox::generate(0, 0, 0, 1, out);
+			TEST(out[0] == 0x6627E8D5U);
+			TEST(out[1] == 0xE169C58DU);
+			TEST(out[2] == 0xBC57AC4CU);
+			TEST(out[3] == 0x9B00DBD8U);
+
+			Philox g1(7, 3);
+			for (size_t i = 0; i < 4*100; ++i)
+				g1();
+
+			Philox g2(7, 3, 100);
+			for (size_t i = 0; i < 1000; ++i)
+				TEST(g1() == g2());
+
+			// quartets vs one block at a time (the counter carry on x64)
+			const Philox::size_type base = (4 < sizeof(Philox::size_type))
+				? Philox::size_type(0xFFFFFFFFU) - 17 : 1000;
+			std::vector<unsigned int> all(4*37);
+			Philox::generate(0x12345678U, 5, base, 37, &all[0]);
+			for (size_t b = 0; b < 37; ++b)
+			{
+				Philox::generate(0x12345678U, 5, base + b, 1, out);
+				for (size_t i = 0; i < 4; ++i)
+					TEST(out[i] == all[4*b + i]);
+			}
+		}
+		os << "done\n";
+
+		// Xoshiro known answers
+		os << " Xoshiro testing.........";
+		{
+			Xoshiro g1, g2;
+			const RandomBits x = g1.next();
+			TEST(x == ((RandomBits(0x99EC5F36U) << 32) | 0xCB75F2B4U));
+			TEST(g2() == RandomValue(x & 0xFFFFFFFFU));
+			TEST(g2() == RandomValue(x >> 32));
+
+			g1.jump();
+			g2.jump();
+			TEST(g1.next() == g2.next());
+		}
+		os << "done\n";
+
+		// Sobol sequence
+		os << " Sobol testing...........";
+		{
+			Sobol g1(3);
+			TEST(g1() == 0.0 && g1() == 0.0 && g1() == 0.0);
+			TEST(g1() == 0.5 && g1() == 0.5 && g1() == 0.5);
+			TEST(g1() == 0.75 && g1() == 0.25 && g1() == 0.25);
+
+			// one point per 1/1024 interval
+			Sobol g2(2, 12345);
+			std::vector<unsigned int> pts(2*1024);
+			g2.generate(1024, &pts[0]);
+			for (size_t d = 0; d < 2; ++d)
+			{
+				std::vector<int> count(1024);
+				for (size_t i = 0; i < 1024; ++i)
+					count[pts[2*i + d] >> 22] += 1;
+				for (size_t i = 0; i < 1024; ++i)
+					TEST(1 == count[i]);
+			}
+
+			Sobol g3(2, 12345);
+			g3.skip(1000);
+			TEST(g3() == pts[2*1000]/4294967296.0);
+		}
+		os << "done\n";
+
+		// Random jump-ahead
+		os << " jump testing............";
+		{
+			const size_t steps[] = { 1, 623, 624, 625, 40000, 100000 };
+			for (size_t k = 0; k < sizeof(steps)/sizeof(steps[0]); ++k)
+			{
+				Random g1(k), g2(k);
+				for (size_t i = 0; i < 100+k; ++i)
+					{ g1(); g2(); }
+
+				for (size_t i = 0; i < steps[k]; ++i)
+					g1();
+				g2.jump(steps[k]);
+
+				for (size_t i = 0; i < 1000; ++i)
+					TEST(g1() == g2());
+			}
+
+			Random g;
+			std::vector<Random> gs = g.split(2, 16);
+			for (size_t i = 0; i < (1<<16); ++i)
+				gs[0]();
+			for (size_t i = 0; i < 1000; ++i)
+				TEST(gs[0]() == gs[1]());
+		}
+		os << "done\n";
+
+		// bulk generation
+		os << " fill testing............";
+		{
+			Normal g1(3), g2(3);
+			g1(); g2();
+
+			double buf[101];
+			g2.fill(buf, 101, 2.0);
+			for (size_t i = 0; i < 101; ++i)
+				TEST(buf[i] == g1(2.0));
+			TEST(g1() == g2());
+		}
+		os << "done\n";
+
+		// packed bits
+		os << " bits testing............";
+		{
+			Random g1(5);
+			Bits g2(5);
+
+			RandomBits words[3];
+			g2.fill(words, 3);
+			for (size_t i = 0; i < 3; ++i)
+			{
+				const RandomValue lo = g1();
+				const RandomValue hi = g1();
+				TEST(words[i] == (RandomBits(lo) | (RandomBits(hi) << 32)));
+			}
+
+			std::vector<int> bits(150);
+			omni::util::unpack_lsb(words, bits.size(), bits.begin());
+
+			omni::util::BitIterator<RandomBits> first(words);
+			TEST(std::vector<int>(first, first + 150) == bits);
+			TEST(first[64+7] == int(words[1]>>7 & 1));
+			TEST(omni::util::bi2de_lsb<RandomBits>(first + 64, 64) == words[1]);
+		}
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	RandTest g_RandTest;
+
+} // unit test
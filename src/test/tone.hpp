@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+//		This material is provided "as is", with absolutely no warranty
+//	expressed or implied. Any use is at your own risk.
+//
+//		Permission to use or copy this software for any purpose is hereby
+//	granted without fee, provided the above notices are retained on all
+//	copies. Permission to modify the code and to distribute modified code
+//	is granted, provided the above notices are retained, and a notice that
+//	the code was modified is included with the above copyright notice.
+//
+//		https://bitbucket.org/pilatuz/omni
+///////////////////////////////////////////////////////////////////////////////
+/** @file
+@brief The unit-test of <omni/dsp/tone.h>.
+@author Sergey Polichnoy <pilatuz@gmail.com>
+*/
+#include <omni/dsp/tone.h>
+#include <omni/util.hpp>
+#include <test/test.hpp>
+
+#include <ostream>
+#include <complex>
+#include <vector>
+#include <math.h>
+
+// unit test
+namespace
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief The omni::dsp::SlidingDFT and omni::dsp::Goertzel unit test.
+class ToneTest:
+	public omni::test::UnitTest
+{
+private:
+
+	// test title
+	virtual const char* title() const
+	{
+		return "omni::dsp::SlidingDFT";
+	}
+
+private:
+
+	// test signal
+	template<typename T>
+	static std::vector< std::complex<T> > signal(size_t N)
+	{
+		std::vector< std::complex<T> > x(N);
+		for (size_t i = 0; i < N; ++i)
+			x[i] = std::complex<T>(T(sin(0.3*i + 0.1*i*i)), T(cos(1.7*i)));
+
+		return x;
+	}
+
+	// DFT value of x[first..first+N) at bin f (reference)
+	template<typename T>
+	static std::complex<double> direct(const std::vector< std::complex<T> > &x,
+		size_t first, size_t N, double f)
+	{
+		std::complex<double> sum;
+		for (size_t m = 0; m < N; ++m)
+			sum += std::complex<double>(x[first + m]) * std::polar(1.0, -2*omni::util::PI*f*m / N);
+
+		return sum;
+	}
+
+	// check sliding DFT at several positions
+	template<typename T>
+	static bool check_sliding(size_t N, double eps)
+	{
+		const std::vector< std::complex<T> > x = signal<T>(20*N + 7);
+
+		std::vector<size_t> bins;
+		bins.push_back(0);
+		bins.push_back(1);
+		bins.push_back(N/3);
+		bins.push_back(N-1);
+		bins.push_back(N+2); // same as 2
+
+		omni::dsp::SlidingDFT<T> sdft(N, bins);
+		std::vector< std::complex<T> > X;
+
+		for (size_t pos = 0, n = 1; pos + n <= x.size(); n = 2*n+1)
+		{
+			sdft.put(&x[pos], n);
+			pos += n;
+			if (pos < N)
+				continue;
+
+			sdft.get(X);
+			for (size_t i = 0; i < bins.size(); ++i)
+				if (eps*N < std::abs(std::complex<double>(X[i]) - direct(x, pos-N, N, double(bins[i]%N))))
+					return false;
+		}
+
+		return true;
+	}
+
+	// check Goertzel bank
+	template<typename T>
+	static bool check_goertzel(size_t N, double eps)
+	{
+		const std::vector< std::complex<T> > x = signal<T>(N);
+
+		std::vector<double> bins;
+		for (size_t i = 0; i < 7; ++i)
+			bins.push_back(0.75*i*i);
+
+		omni::dsp::Goertzel<T> bank(N, bins);
+		bank.put(&x[0], N/3);
+		bank.put(&x[N/3], N - N/3);
+		if (bank.count() != N)
+			return false;
+
+		std::vector< std::complex<T> > X;
+		bank.get(X);
+		for (size_t i = 0; i < bins.size(); ++i)
+			if (eps*N < std::abs(std::complex<double>(X[i]) - direct(x, 0, N, bins[i])))
+				return false;
+
+		return true;
+	}
+
+private:
+
+	// test function
+	virtual bool do_test(std::ostream &os) const
+	{
+#define TEST(expr) if (expr) {} else { os << "expression failed: \"" \
+	<< #expr << "\" at line " << __LINE__ << "\n"; return false; }
+
+		os << " sliding testing.........";
+		TEST(check_sliding<double>(1, 1e-12));
+		TEST(check_sliding<double>(64, 1e-12));
+		TEST(check_sliding<double>(100, 1e-12));
+		TEST(check_sliding<float>(100, 1e-5));
+		os << "done\n";
+
+		os << " Goertzel testing........";
+		TEST(check_goertzel<double>(64, 1e-10));
+		TEST(check_goertzel<double>(1000, 1e-10));
+		TEST(check_goertzel<float>(100, 1e-4));
+		os << "done\n";
+
+#undef TEST
+		return true;
+	}
+};
+
+	// global instance
+	ToneTest g_ToneTest;
+
+} // unit test